@@ -1,12 +1,12 @@
 QT       += core gui
-QT       += multimedia
-QT       += multimediawidgets
+QT       += network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 win32 {
     LIBS += -L C:\msys64\mingw64\lib\vlc
     QT += winextras
+    LIBS += -lpsapi
 }
 
 LIBS += -lvlc
@@ -25,35 +25,102 @@ CONFIG += c++11
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    src/components/backgroundaudiomode.cpp \
     src/components/chapterlistpage.cpp \
+    src/components/decodequalitygovernor.cpp \
+    src/components/firstframetimer.cpp \
+    src/components/framegrabber.cpp \
+    src/components/framepool.cpp \
+    src/components/frameview.cpp \
+    src/components/keyframeindexer.cpp \
     src/components/mainpage.cpp \
+    src/components/playbackstats.cpp \
     src/components/pictureinpicturewindow.cpp \
     src/components/playercontroller.cpp \
+    src/components/playerstyle.cpp \
     src/components/playlistpage.cpp \
     src/components/screenmessage.cpp \
+    src/components/seekscheduler.cpp \
+    src/components/snapshotgrabber.cpp \
+    src/components/snapshotpipeline.cpp \
+    src/components/spritesheetgenerator.cpp \
+    src/components/statsoverlay.cpp \
+    src/components/thumbnailpopup.cpp \
+    src/components/thumbnailprovider.cpp \
+    src/components/videosurface.cpp \
     src/dialogs/about.cpp \
     src/dialogs/gototime.cpp \
+    src/benchmarks.cpp \
+    src/cpuloadsimulator.cpp \
+    src/framedownscaler.cpp \
+    src/iconatlas.cpp \
+    src/keyframeindex.cpp \
     src/main.cpp \
     src/mainwindow.cpp \
+    src/mediaformats.cpp \
+    src/performanceprofile.cpp \
+    src/plugincache.cpp \
     src/settings.cpp \
-    src/shared.cpp
+    src/shared.cpp \
+    src/singleinstance.cpp \
+    src/spritesheet.cpp \
+    src/stallwatchdog.cpp \
+    src/startuptrace.cpp \
+    src/timeformat.cpp \
+    src/tracer.cpp \
+    src/vlcloader.cpp \
+    src/wakeupcounter.cpp
 
 HEADERS += \
+    src/components/backgroundaudiomode.h \
     src/components/chapterlistpage.h \
+    src/components/decodequalitygovernor.h \
+    src/components/firstframetimer.h \
+    src/components/framegrabber.h \
+    src/components/framepool.h \
+    src/components/frameview.h \
+    src/components/keyframeindexer.h \
     src/components/mainpage.h \
     src/components/mediaprogressslider.h \
     src/components/mediavolumeslider.h \
+    src/components/playbackstats.h \
     src/components/pictureinpicturewindow.h \
     src/components/playercontroller.h \
+    src/components/playerstyle.h \
     src/components/playlistdock.h \
     src/components/playlistpage.h \
     src/components/screenmessage.h \
+    src/components/seekscheduler.h \
+    src/components/snapshotgrabber.h \
+    src/components/snapshotpipeline.h \
+    src/components/spritesheetgenerator.h \
+    src/components/statsoverlay.h \
+    src/components/thumbnailpopup.h \
+    src/components/thumbnailprovider.h \
     src/components/videoWidget.h \
+    src/components/videosurface.h \
+    src/benchmarks.h \
+    src/cpuloadsimulator.h \
     src/dialogs/about.h \
     src/dialogs/gototime.h \
+    src/framedownscaler.h \
+    src/iconatlas.h \
+    src/keyframeindex.h \
     src/mainwindow.h \
+    src/mediaformats.h \
+    src/performanceprofile.h \
+    src/plugincache.h \
+    src/ringbuffer.h \
     src/settings.h \
     src/shared.h \
+    src/singleinstance.h \
+    src/spritesheet.h \
+    src/stallwatchdog.h \
+    src/startuptrace.h \
+    src/timeformat.h \
+    src/tracer.h \
+    src/vlcloader.h \
+    src/wakeupcounter.h \
     vlcqt/Enums.h \
     vlcqt/Equalizer.h \
     vlcqt/Instance.h \
@@ -0,0 +1,99 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "benchmarks.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include "mediaformats.h"
+#include "shared.h"
+#include "timeformat.h"
+
+const int ITERATIONS = 1000000;
+
+bool Benchmarks::run(const QStringList &arguments)
+{
+    bool ran = false;
+
+    for(const QString& argument : arguments)
+    {
+        if(! argument.startsWith("--benchmark="))
+            continue;
+
+        QString name = argument.section('=', 1);
+        if(name == "classifier")
+            classifyExtensions();
+        else if(name == "time-formatting")
+            formatTimes();
+        else
+            qWarning() << "Benchmarks: unknown benchmark" << name << "- available: classifier, time-formatting";
+
+        ran = true;
+    }
+
+    return ran;
+}
+
+void Benchmarks::classifyExtensions()
+{
+    const QStringList paths = {"C:/Videos/Holiday.MKV", "/home/user/music/track01.flac", "movie.subs.srt",
+                               "notes.txt", "archive.tar.gz", "/no/extension", "clip.mp4", "list.m3u8"};
+    int matches = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for(int i = 0; i < ITERATIONS; ++i)
+    {
+        if(MediaFormats::kindsOfPath(paths.at(i % paths.size())) & MediaFormats::PLAYABLE)
+            ++matches;
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    qInfo() << "Classified" << ITERATIONS << "paths in" << elapsed / 1000000.0 << "ms,"
+            << double(elapsed) / ITERATIONS << "ns per path," << matches << "playable";
+}
+
+void Benchmarks::formatTimes()
+{
+    char buffer[TIME_TEXT_CAPACITY];
+    qint64 checksum = 0;
+    QElapsedTimer timer;
+
+    timer.start();
+    for(int i = 0; i < ITERATIONS; ++i)
+        checksum += formatTime(i * 37LL, buffer);
+    qInfo() << "formatTime:" << double(timer.nsecsElapsed()) / ITERATIONS << "ns per call";
+
+    timer.restart();
+    for(int i = 0; i < ITERATIONS; ++i)
+        checksum += formattedTime(i * 37LL).size();
+    qInfo() << "formattedTime:" << double(timer.nsecsElapsed()) / ITERATIONS << "ns per call";
+
+    // what the slider does: timeChanged every ~250 ms of media time
+    TimeText text;
+    timer.restart();
+    for(int i = 0; i < ITERATIONS; ++i)
+        checksum += text.setTime(i * 250LL) ? text.text().size() : 0;
+    qInfo() << "TimeText at 4 updates/s:" << double(timer.nsecsElapsed()) / ITERATIONS << "ns per call";
+
+    timer.restart();
+    for(int i = 0; i < ITERATIONS; ++i)
+        checksum += parseTime(QStringLiteral("01:23:45"));
+    qInfo() << "parseTime:" << double(timer.nsecsElapsed()) / ITERATIONS << "ns per call" << checksum;
+}
@@ -0,0 +1,37 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <QStringList>
+
+// Micro-benchmarks of the hot helpers, run with --benchmark=<name> instead of
+// starting the player. The results go to the log.
+class Benchmarks
+{
+public:
+    // true when a benchmark ran and the process should quit
+    static bool run(const QStringList& arguments);
+
+private:
+    static void classifyExtensions();
+    static void formatTimes();
+};
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,136 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "backgroundaudiomode.h"
+#include "seekscheduler.h"
+
+#include <QDebug>
+
+#include "vlcqt/MediaPlayer.h"
+#include "../tracer.h"
+
+// long enough for alt-tab or a quick look at another window not to cost a decoder restart
+const int GRACE_PERIOD = 5000;
+
+BackgroundAudioMode::BackgroundAudioMode(VlcMediaPlayer *player, SeekScheduler *seekScheduler, QObject *parent)
+    : QObject(parent),
+      mPlayer(player),
+      mSeekScheduler(seekScheduler),
+      videoTrack(-1),
+      enabled(true),
+      videoVisible(true)
+{
+    graceTimer.setSingleShot(true);
+    graceTimer.setInterval(GRACE_PERIOD);
+    connect(&graceTimer, &QTimer::timeout, this, &BackgroundAudioMode::enter);
+}
+
+void BackgroundAudioMode::setEnabled(bool enable)
+{
+    enabled = enable;
+
+    if(! enabled)
+    {
+        graceTimer.stop();
+        leave();
+    }
+    else if(! videoVisible)
+    {
+        graceTimer.start();
+    }
+}
+
+bool BackgroundAudioMode::isEnabled() const
+{
+    return enabled;
+}
+
+bool BackgroundAudioMode::isActive() const
+{
+    return videoTrack >= 0;
+}
+
+void BackgroundAudioMode::setVideoVisible(bool visible)
+{
+    if(visible == videoVisible)
+        return;
+
+    videoVisible = visible;
+
+    if(visible)
+    {
+        graceTimer.stop();
+        leave();
+    }
+    else if(enabled)
+    {
+        graceTimer.start();
+    }
+}
+
+void BackgroundAudioMode::reset()
+{
+    // a new media starts with its video track selected again
+    if(isActive())
+    {
+        videoTrack = -1;
+        emit activeChanged(false);
+    }
+
+    if(enabled && ! videoVisible)
+        graceTimer.start();
+}
+
+void BackgroundAudioMode::onPlaybackStarted()
+{
+    // the grace period may have run out while paused
+    if(enabled && ! videoVisible && ! isActive() && ! graceTimer.isActive())
+        graceTimer.start();
+}
+
+void BackgroundAudioMode::enter()
+{
+    int track = mPlayer->track();
+    if(isActive() || track < 0 || mPlayer->state() != Vlc::Playing)
+        return;
+
+    TRACE_SCOPE("BackgroundAudioMode::enter");
+    videoTrack = track;
+    mPlayer->setVideoTrack(-1);
+    qInfo() << "Background audio: video track" << track << "deselected";
+    emit activeChanged(true);
+}
+
+void BackgroundAudioMode::leave()
+{
+    if(! isActive())
+        return;
+
+    TRACE_SCOPE("BackgroundAudioMode::leave");
+    int track = videoTrack;
+    videoTrack = -1;
+
+    // the decoder restarts at a keyframe, the seek makes it show the frame that belongs to the audio
+    qint64 time = mPlayer->time();
+    mPlayer->setVideoTrack(track);
+    if(time >= 0)
+        mSeekScheduler->seekTo(time);
+
+    qInfo() << "Background audio: video track" << track << "restored at" << time << "ms";
+    emit activeChanged(false);
+}
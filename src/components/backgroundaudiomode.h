@@ -0,0 +1,62 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef BACKGROUNDAUDIOMODE_H
+#define BACKGROUNDAUDIOMODE_H
+
+#include <QObject>
+#include <QTimer>
+
+class VlcMediaPlayer;
+class SeekScheduler;
+
+// Stops decoding video while nobody can see it. Once the video has been
+// hidden for a grace period the video track is deselected, and when it is
+// visible again the track is restored and the player seeks to where audio
+// is, so the picture resumes at the right frame instead of the next keyframe.
+class BackgroundAudioMode : public QObject
+{
+    Q_OBJECT
+public:
+    BackgroundAudioMode(VlcMediaPlayer* player, SeekScheduler* seekScheduler, QObject *parent = nullptr);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    bool isActive() const;
+
+public slots:
+    void setVideoVisible(bool visible);
+    void reset();
+    void onPlaybackStarted();
+
+signals:
+    void activeChanged(bool active);
+
+private:
+    void enter();
+    void leave();
+
+    VlcMediaPlayer* mPlayer;
+    SeekScheduler* mSeekScheduler;
+    QTimer graceTimer;
+    int videoTrack;
+    bool enabled;
+    bool videoVisible;
+};
+
+#endif // BACKGROUNDAUDIOMODE_H
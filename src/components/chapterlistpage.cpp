@@ -25,9 +25,13 @@
 #include <QScrollBar>
 #include <QHeaderView>
 #include <QMouseEvent>
+#include <QIcon>
+#include <QPixmap>
 
 #include "../shared.h"
 
+const int CHAPTER_THUMBNAIL_WIDTH = 64;
+
 ChapterListPage::ChapterListPage()
 {
     this->setColumnCount(2);
@@ -127,6 +131,22 @@ void ChapterListPage::syncToVideoTimeOnShow()
     syncOnShow = true;
 }
 
+const QList<qint64> &ChapterListPage::chapterTimestamps() const
+{
+    return timeStamps;
+}
+
+void ChapterListPage::setChapterThumbnails(const QList<QImage> &thumbnails)
+{
+    this->setIconSize(QSize(CHAPTER_THUMBNAIL_WIDTH, CHAPTER_THUMBNAIL_WIDTH * 9 / 16));
+
+    for(int row = 0; row < this->rowCount() && row < thumbnails.size(); ++row)
+    {
+        if(! thumbnails.at(row).isNull())
+            this->item(row, 0)->setIcon(QIcon(QPixmap::fromImage(thumbnails.at(row))));
+    }
+}
+
 void ChapterListPage::popupMenuTableShow(const QPoint &pos)
 {
     QTableWidgetItem* item = this->itemAt(pos);
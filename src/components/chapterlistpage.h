@@ -34,6 +34,8 @@ public:
     void syncToVideoTime(QString currentChapterTimestamp);
     void updateCurrentChapter(QString currentChapterTimestamp);
     void syncToVideoTimeOnShow();
+    const QList<qint64>& chapterTimestamps() const;
+    void setChapterThumbnails(const QList<QImage>& thumbnails);
 
 signals:
     void jumpToChapter(int time);
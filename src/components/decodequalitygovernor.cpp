@@ -0,0 +1,180 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "decodequalitygovernor.h"
+
+#include <QDebug>
+
+#include "vlcqt/MediaPlayer.h"
+
+// more than 5% of the video frames or of the audio buffers lost in two samples
+// in a row steps down, ten clean seconds (at the default 500 ms sampling) step
+// back up
+const float LOSS_RATIO_THRESHOLD = 0.05f;
+const int SAMPLES_TO_STEP_DOWN = 2;
+const int SAMPLES_TO_STEP_UP = 20;
+const int REDUCED_PIP_FPS = 15;
+
+DecodeQualityGovernor::DecodeQualityGovernor(VlcMediaPlayer *player, QObject *parent)
+    : QObject(parent),
+      mPlayer(player),
+      currentLevel(FULL_QUALITY),
+      enabled(true),
+      overloadedSamples(0),
+      healthySamples(0)
+{
+}
+
+DecodeQualityGovernor::Level DecodeQualityGovernor::level() const
+{
+    return currentLevel;
+}
+
+// the whole option list of a media opened at the current level, later options win
+QStringList DecodeQualityGovernor::mediaOptions() const
+{
+    QStringList options = baselineOptions;
+
+    // the deblocking filter is a large share of H.264/HEVC decode time, dropping it keeps every frame
+    if(currentLevel >= SKIP_LOOP_FILTER)
+        options << ":avcodec-skiploopfilter=4" << ":avcodec-fast";
+
+    if(currentLevel >= SKIP_NON_REFERENCE_FRAMES)
+        options << ":avcodec-skip-frame=1";
+
+    return options;
+}
+
+void DecodeQualityGovernor::setBaselineOptions(const QStringList &options)
+{
+    baselineOptions = options;
+}
+
+int DecodeQualityGovernor::pipFrameRateCap() const
+{
+    return (currentLevel >= REDUCED_PIP_FRAME_RATE) ? REDUCED_PIP_FPS : 0;
+}
+
+void DecodeQualityGovernor::setEnabled(bool enable)
+{
+    enabled = enable;
+
+    if(! enabled)
+        setLevel(FULL_QUALITY, "governor disabled");
+}
+
+bool DecodeQualityGovernor::isEnabled() const
+{
+    return enabled;
+}
+
+QString DecodeQualityGovernor::levelName(Level level)
+{
+    switch (level)
+    {
+    case FULL_QUALITY:
+        return "full quality";
+    case SKIP_LOOP_FILTER:
+        return "skip loop filter";
+    case SKIP_NON_REFERENCE_FRAMES:
+        return "skip non-reference frames";
+    case REDUCED_PIP_FRAME_RATE:
+        return "reduced PiP frame rate";
+    }
+
+    return QString();
+}
+
+void DecodeQualityGovernor::onSample(const PlaybackStatsSample &sample)
+{
+    if(! enabled)
+        return;
+
+    // frames and audio buffers are counted apart, a video frame is not worth an audio buffer
+    int videoTotal = sample.decodedVideo + sample.lostPictures;
+    int audioTotal = sample.decodedAudio + sample.lostAudioBuffers;
+    float videoLossRatio = (videoTotal > 0) ? float(sample.lostPictures) / videoTotal : 0;
+    float audioLossRatio = (audioTotal > 0) ? float(sample.lostAudioBuffers) / audioTotal : 0;
+
+    if(videoLossRatio > LOSS_RATIO_THRESHOLD || audioLossRatio > LOSS_RATIO_THRESHOLD)
+    {
+        healthySamples = 0;
+
+        if(++overloadedSamples >= SAMPLES_TO_STEP_DOWN && currentLevel < REDUCED_PIP_FRAME_RATE)
+        {
+            QString reason = (videoLossRatio > LOSS_RATIO_THRESHOLD) ?
+                        QString("%1 of %2 frames lost").arg(sample.lostPictures).arg(videoTotal) :
+                        QString("%1 of %2 audio buffers lost").arg(sample.lostAudioBuffers).arg(audioTotal);
+            setLevel(Level(currentLevel + 1), reason);
+        }
+    }
+    else if(sample.lostPictures == 0 && sample.lostAudioBuffers == 0)
+    {
+        overloadedSamples = 0;
+
+        if(++healthySamples >= SAMPLES_TO_STEP_UP && currentLevel > FULL_QUALITY)
+        {
+            setLevel(Level(currentLevel - 1), "no frames lost");
+        }
+    }
+    else
+    {
+        // some losses but under the threshold, hold the current level
+        overloadedSamples = 0;
+        healthySamples = 0;
+    }
+}
+
+void DecodeQualityGovernor::reset()
+{
+    // a new media starts at full quality, MainPage opens it with the baseline options
+    if(currentLevel != FULL_QUALITY)
+    {
+        qInfo() << "Decode governor:" << levelName(currentLevel) << "->" << levelName(FULL_QUALITY) << "(media changed)";
+        currentLevel = FULL_QUALITY;
+        emit levelChanged(currentLevel);
+        emit pipFrameRateCapChanged(0);
+    }
+
+    overloadedSamples = 0;
+    healthySamples = 0;
+}
+
+void DecodeQualityGovernor::setLevel(Level newLevel, const QString &reason)
+{
+    overloadedSamples = 0;
+    healthySamples = 0;
+
+    if(newLevel == currentLevel)
+        return;
+
+    Level oldLevel = currentLevel;
+    currentLevel = newLevel;
+
+    qInfo() << "Decode governor:" << levelName(oldLevel) << "->" << levelName(newLevel) << "(" + reason + ")";
+
+    // the reduced PiP frame rate is the only level that leaves the decoder alone
+    bool decoderOptionsChanged = qMin(oldLevel, SKIP_NON_REFERENCE_FRAMES) != qMin(newLevel, SKIP_NON_REFERENCE_FRAMES);
+    if(decoderOptionsChanged && mPlayer->currentMedia())
+        emit reopenRequested();
+
+    if((oldLevel >= REDUCED_PIP_FRAME_RATE) != (newLevel >= REDUCED_PIP_FRAME_RATE))
+        emit pipFrameRateCapChanged(pipFrameRateCap());
+
+    emit levelChanged(currentLevel);
+}
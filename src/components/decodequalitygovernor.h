@@ -0,0 +1,74 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef DECODEQUALITYGOVERNOR_H
+#define DECODEQUALITYGOVERNOR_H
+
+#include <QObject>
+#include <QStringList>
+
+#include "playbackstats.h"
+
+class VlcMediaPlayer;
+
+class DecodeQualityGovernor : public QObject
+{
+    Q_OBJECT
+public:
+    enum Level
+    {
+        FULL_QUALITY,
+        SKIP_LOOP_FILTER,
+        SKIP_NON_REFERENCE_FRAMES,
+        REDUCED_PIP_FRAME_RATE
+    };
+
+    explicit DecodeQualityGovernor(VlcMediaPlayer* player, QObject *parent = nullptr);
+
+    Level level() const;
+    QStringList mediaOptions() const;
+    void setBaselineOptions(const QStringList& options);
+    int pipFrameRateCap() const;
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    static QString levelName(Level level);
+
+signals:
+    void levelChanged(DecodeQualityGovernor::Level level);
+    void pipFrameRateCapChanged(int fps);
+    // decoder options are only read when libvlc creates the input, the
+    // current media has to be opened again with mediaOptions()
+    void reopenRequested();
+
+public slots:
+    void onSample(const PlaybackStatsSample& sample);
+    void reset();
+
+private:
+    void setLevel(Level newLevel, const QString& reason);
+
+    VlcMediaPlayer* mPlayer;
+    Level currentLevel;
+    bool enabled;
+    int overloadedSamples;
+    int healthySamples;
+    QStringList baselineOptions;
+};
+
+#endif // DECODEQUALITYGOVERNOR_H
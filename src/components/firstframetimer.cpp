@@ -0,0 +1,105 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "firstframetimer.h"
+
+#include <QDebug>
+
+#include "vlcqt/MediaPlayer.h"
+
+FirstFrameTimer::FirstFrameTimer(VlcMediaPlayer *player, QObject *parent)
+    : QObject(parent),
+      startedAt(-1),
+      playingAt(-1),
+      firstFrameAt(-1),
+      fastStart(false)
+{
+    clock.start();
+
+    connect(player, &VlcMediaPlayer::playing, this, [this]
+    {
+        qint64 expected = -1;
+        if(startedAt.load() >= 0)
+            playingAt.compare_exchange_strong(expected, clock.elapsed());
+    }, Qt::DirectConnection);
+
+    connect(player, &VlcMediaPlayer::vout, this, [this] (int count)
+    {
+        qint64 expected = -1;
+        if(count > 0 && startedAt.load() >= 0 && firstFrameAt.compare_exchange_strong(expected, clock.elapsed()))
+            QMetaObject::invokeMethod(this, [this] { finish(); });
+    }, Qt::DirectConnection);
+}
+
+void FirstFrameTimer::start(const QString &fileName, bool fastStart)
+{
+    // the previous file played without ever showing a picture
+    if(startedAt.load() >= 0 && playingAt.load() >= 0)
+        finish();
+
+    this->fileName = fileName;
+    this->fastStart = fastStart;
+    playingAt.store(-1);
+    firstFrameAt.store(-1);
+    startedAt.store(clock.elapsed());
+}
+
+const FirstFrameTimer::History &FirstFrameTimer::history() const
+{
+    return results;
+}
+
+void FirstFrameTimer::finish()
+{
+    qint64 started = startedAt.exchange(-1);
+    if(started < 0)
+        return;
+
+    qint64 playing = playingAt.load();
+    qint64 firstFrame = firstFrameAt.load();
+
+    Result result;
+    result.fileName = fileName;
+    result.playing = playing >= 0 ? playing - started : -1;
+    result.firstFrame = firstFrame >= 0 ? firstFrame - started : -1;
+    result.fastStart = fastStart;
+    results.push(result);
+
+    qInfo().noquote() << QString("Time to first frame: %1 ms (playing after %2 ms)%3 for %4")
+                         .arg(result.firstFrame).arg(result.playing)
+                         .arg(fastStart ? " with fast start" : "", fileName);
+
+    emit measured(result);
+}
+
+QString FirstFrameTimer::report() const
+{
+    if(results.isEmpty())
+        return tr("No file opened yet");
+
+    QString text = tr("Time to first frame, newest first:");
+    for(std::size_t i = results.size(); i-- > 0;)
+    {
+        const Result& result = results.at(i);
+        QString firstFrame = result.firstFrame >= 0 ? QString("%1 ms").arg(result.firstFrame) : tr("no video");
+        text += QString("\n%1  (playing %2 ms)%3  %4").arg(firstFrame, 8).arg(result.playing)
+                .arg(result.fastStart ? tr("  fast start") : "", result.fileName);
+    }
+
+    return text;
+}
@@ -0,0 +1,70 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef FIRSTFRAMETIMER_H
+#define FIRSTFRAMETIMER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <atomic>
+
+#include "../ringbuffer.h"
+
+class VlcMediaPlayer;
+
+// Time to first frame: from the request to open a file until libvlc reports
+// it playing and until its first picture is out. The libvlc events are timed
+// on the thread that raises them, so a busy GUI thread does not inflate the
+// numbers.
+class FirstFrameTimer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Result
+    {
+        QString fileName;
+        qint64 playing;         // ms, -1 when it never got there
+        qint64 firstFrame;      // ms, -1 for files without video
+        bool fastStart;
+    };
+
+    enum { HISTORY_SIZE = 32 };
+    typedef RingBuffer<Result, HISTORY_SIZE> History;
+
+    explicit FirstFrameTimer(VlcMediaPlayer* player, QObject *parent = nullptr);
+
+    void start(const QString& fileName, bool fastStart);
+    const History& history() const;
+    QString report() const;
+
+signals:
+    void measured(const FirstFrameTimer::Result& result);
+
+private:
+    void finish();
+
+    QElapsedTimer clock;
+    std::atomic<qint64> startedAt;  // clock ms, -1 while nothing is being timed
+    std::atomic<qint64> playingAt;
+    std::atomic<qint64> firstFrameAt;
+    QString fileName;
+    bool fastStart;
+    History results;
+};
+
+#endif // FIRSTFRAMETIMER_H
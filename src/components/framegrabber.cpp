@@ -0,0 +1,236 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "framegrabber.h"
+
+#include <QDir>
+#include <QDebug>
+#include <cstring>
+
+// a seek that shows nothing within this time is given up (e.g. past the last frame)
+const int GRAB_TIMEOUT = 1000;
+// a file that shows no first frame within this time did not open or cannot be decoded
+const int OPEN_TIMEOUT = 5000;
+// the frame shown after a fast seek is the keyframe before the target, which can be far away
+const qint64 KEYFRAME_TOLERANCE = 15000;
+
+FrameGrabber::FrameGrabber(libvlc_instance_t *instance, int frameWidth, QObject *parent)
+    : QObject(parent),
+      instance(instance),
+      player(nullptr),
+      frameWidth(frameWidth),
+      generation(0),
+      session(0),
+      state(CLOSED),
+      pendingTime(-1),
+      inFlightTime(-1),
+      grabTimeout(this),
+      openTimeout(this)
+{
+    grabTimeout.setSingleShot(true);
+    grabTimeout.setInterval(GRAB_TIMEOUT);
+    connect(&grabTimeout, &QTimer::timeout, this, [this]
+    {
+        emit grabFailed(generation, inFlightTime);
+        inFlightTime = -1;
+        if(pendingTime >= 0)
+            issue();
+    });
+
+    openTimeout.setSingleShot(true);
+    openTimeout.setInterval(OPEN_TIMEOUT);
+    connect(&openTimeout, &QTimer::timeout, this, [this]
+    {
+        qWarning() << "Frame grabber: no first frame after" << OPEN_TIMEOUT << "ms";
+        qint64 time = pendingTime;
+        close();
+        state = FAILED;
+        if(time >= 0)
+            emit grabFailed(generation, time);
+    });
+}
+
+FrameGrabber::~FrameGrabber()
+{
+    close();
+}
+
+void FrameGrabber::open(int newGeneration, const QString &filePath)
+{
+    close();
+    generation = newGeneration;
+    ++session;
+
+    libvlc_media_t* media = libvlc_media_new_path(instance, QDir::toNativeSeparators(filePath).toUtf8().constData());
+    if(! media)
+    {
+        state = FAILED;
+        return;
+    }
+
+    // no audio, no subtitles and the cheapest decoding, this must not compete with playback
+    for(const char* option : {":no-audio", ":no-spu", ":no-sub-autodetect-file", ":no-video-title-show",
+        ":input-fast-seek", ":avcodec-threads=1", ":avcodec-skiploopfilter=4", ":avcodec-hw=none"})
+    {
+        libvlc_media_add_option(media, option);
+    }
+
+    player = libvlc_media_player_new_from_media(media);
+    libvlc_media_release(media);
+    if(! player)
+    {
+        state = FAILED;
+        return;
+    }
+
+    libvlc_video_set_callbacks(player, lockCallback, unlockCallback, displayCallback, this);
+    libvlc_video_set_format_callbacks(player, formatCallback, nullptr);
+
+    state = OPENING;
+    openTimeout.start();
+    libvlc_media_player_play(player);
+}
+
+void FrameGrabber::close()
+{
+    grabTimeout.stop();
+    openTimeout.stop();
+    pendingTime = -1;
+    inFlightTime = -1;
+    state = CLOSED;
+
+    if(player)
+    {
+        // stop joins the video output thread, no callback runs after it
+        libvlc_media_player_stop(player);
+        libvlc_media_player_release(player);
+        player = nullptr;
+    }
+}
+
+void FrameGrabber::grab(qint64 time)
+{
+    if(state == CLOSED)
+        return;
+
+    if(state == FAILED)
+    {
+        emit grabFailed(generation, time);
+        return;
+    }
+
+    pendingTime = time;
+
+    if(state == READY && inFlightTime < 0)
+        issue();
+}
+
+void FrameGrabber::issue()
+{
+    inFlightTime = pendingTime;
+    pendingTime = -1;
+    grabTimeout.start();
+
+    libvlc_media_player_set_time(player, inFlightTime);
+}
+
+void FrameGrabber::onFrame(int frameSession, qint64 shownTime, const QImage &image)
+{
+    // a frame of the previously opened file that was still queued
+    if(frameSession != session)
+        return;
+
+    if(state == OPENING)
+    {
+        // the first frame only tells us the decoder is up, stay paused from now on
+        openTimeout.stop();
+        libvlc_media_player_set_pause(player, 1);
+        state = READY;
+        if(pendingTime >= 0)
+            issue();
+        return;
+    }
+
+    if(state != READY || inFlightTime < 0)
+        return;
+
+    // frames still queued from before the seek are not what was asked for, the time is the
+    // one of the frame when it was shown, by now the input may already be at the new one
+    if(shownTime >= 0 && qAbs(shownTime - inFlightTime) > KEYFRAME_TOLERANCE)
+        return;
+
+    grabTimeout.stop();
+    emit frameGrabbed(generation, inFlightTime, image);
+
+    inFlightTime = -1;
+    if(pendingTime >= 0)
+        issue();
+}
+
+unsigned FrameGrabber::formatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                      unsigned *pitches, unsigned *lines)
+{
+    FrameGrabber* self = static_cast<FrameGrabber*>(*opaque);
+
+    // libvlc scales to whatever size is asked for here, keep the aspect and an even height
+    unsigned targetWidth = self->frameWidth;
+    unsigned targetHeight = (*width > 0) ? (*height * targetWidth / *width) : targetWidth * 9 / 16;
+    targetHeight = qMax(2u, targetHeight & ~1u);
+
+    std::memcpy(chroma, "RV32", 4);
+    *width = targetWidth;
+    *height = targetHeight;
+    *pitches = targetWidth * 4;
+    *lines = targetHeight;
+
+    QMutexLocker locker(&self->frameMutex);
+    self->frame = QImage(targetWidth, targetHeight, QImage::Format_RGB32);
+    return 1;
+}
+
+void *FrameGrabber::lockCallback(void *opaque, void **planes)
+{
+    FrameGrabber* self = static_cast<FrameGrabber*>(opaque);
+    self->frameMutex.lock();
+    planes[0] = self->frame.bits();
+    return nullptr;
+}
+
+void FrameGrabber::unlockCallback(void *opaque, void *picture, void *const *planes)
+{
+    Q_UNUSED(picture)
+    Q_UNUSED(planes)
+    static_cast<FrameGrabber*>(opaque)->frameMutex.unlock();
+}
+
+void FrameGrabber::displayCallback(void *opaque, void *picture)
+{
+    Q_UNUSED(picture)
+    FrameGrabber* self = static_cast<FrameGrabber*>(opaque);
+
+    qint64 time = libvlc_media_player_get_time(self->player);
+    QImage image;
+    {
+        QMutexLocker locker(&self->frameMutex);
+        image = self->frame.copy();
+    }
+
+    // session only changes in open(), after the previous player was stopped
+    int frameSession = self->session;
+    QMetaObject::invokeMethod(self, [self, frameSession, time, image] { self->onFrame(frameSession, time, image); }, Qt::QueuedConnection);
+}
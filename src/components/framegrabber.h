@@ -0,0 +1,78 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef FRAMEGRABBER_H
+#define FRAMEGRABBER_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QTimer>
+
+#include <vlc/vlc.h>
+
+// A headless libvlc player that renders small RV32 frames into memory.
+// It lives in its own thread: open() starts the media paused on its first
+// frame, grab() seeks it and reports the next frame that is displayed.
+// Only the latest grab request is kept while a seek is in flight. A file
+// that shows no first frame fails every grab until the next open().
+class FrameGrabber : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FrameGrabber(libvlc_instance_t* instance, int frameWidth, QObject *parent = nullptr);
+    ~FrameGrabber();
+
+public slots:
+    void open(int generation, const QString& filePath);
+    void close();
+    void grab(qint64 time);
+
+signals:
+    void frameGrabbed(int generation, qint64 time, const QImage& image);
+    void grabFailed(int generation, qint64 time);
+
+private:
+    enum State {CLOSED, OPENING, READY, FAILED};
+
+    static unsigned formatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                   unsigned *pitches, unsigned *lines);
+    static void *lockCallback(void *opaque, void **planes);
+    static void unlockCallback(void *opaque, void *picture, void *const *planes);
+    static void displayCallback(void *opaque, void *picture);
+
+    void issue();
+    void onFrame(int session, qint64 shownTime, const QImage& image);
+
+    libvlc_instance_t* instance;
+    libvlc_media_player_t* player;
+    int frameWidth;
+    int generation;
+    int session;
+    State state;
+    qint64 pendingTime;
+    qint64 inFlightTime;
+    QTimer grabTimeout;
+    QTimer openTimeout;
+
+    // shared with the libvlc video output thread
+    QMutex frameMutex;
+    QImage frame;
+};
+
+#endif // FRAMEGRABBER_H
@@ -0,0 +1,264 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "framepool.h"
+
+#include <QPainter>
+#include <cstring>
+
+#include "vlcqt/MediaPlayer.h"
+
+const int BUFFER_ALIGNMENT = 64;
+// weight of the newest display interval in the running average
+const double INTERVAL_SMOOTHING = 0.1;
+const qint64 MAX_FRAME_INTERVAL = 1000;
+
+FramePool::FramePool(QObject *parent)
+    : QObject(parent),
+      spare(nullptr),
+      latest(-1),
+      frameWidth(0),
+      frameHeight(0),
+      framePitch(0),
+      nativeWidth(0),
+      nativeHeight(0),
+      lastDisplay(-1),
+      averageInterval(0),
+      updatePending(0),
+      dropped(0)
+{
+    for(Buffer*& buffer : buffers)
+        buffer = nullptr;
+
+    displayClock.start();
+}
+
+FramePool::~FramePool()
+{
+    // the player is stopped by now, frames still held by consumers stay valid until they let go
+    release();
+}
+
+void FramePool::attach(VlcMediaPlayer *player)
+{
+    player->setVideoCallbacks(formatCallback, cleanupCallback, lockCallback, unlockCallback, displayCallback, this);
+}
+
+QImage FramePool::latestFrame() const
+{
+    QMutexLocker locker(&mutex);
+    if(latest < 0)
+        return QImage();
+
+    Buffer* buffer = buffers[latest];
+    buffer->pins.ref();
+    return QImage(const_cast<const uchar*>(buffer->data), frameWidth, frameHeight, framePitch,
+                  QImage::Format_RGB32, unpin, buffer);
+}
+
+int FramePool::droppedFrames() const
+{
+    return dropped.loadAcquire();
+}
+
+// read when the video output is created, it applies from the next one
+void FramePool::setMaxOutputSize(const QSize &size)
+{
+    QMutexLocker locker(&mutex);
+    maxOutputSize = size;
+}
+
+bool FramePool::isNativeSize() const
+{
+    QMutexLocker locker(&mutex);
+    return frameWidth == nativeWidth && frameHeight == nativeHeight;
+}
+
+double FramePool::frameInterval() const
+{
+    QMutexLocker locker(&mutex);
+    return averageInterval;
+}
+
+void FramePool::paint(QPainter *painter, const QRect &area, const QImage &frame)
+{
+    painter->fillRect(area, Qt::black);
+
+    QSize size = frame.size().scaled(area.size(), Qt::KeepAspectRatio);
+    QRect target(QPoint(area.x() + (area.width() - size.width()) / 2, area.y() + (area.height() - size.height()) / 2), size);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    painter->drawImage(target, frame);
+}
+
+void FramePool::allocate(int width, int height, int pitch, int nativeWidth, int nativeHeight)
+{
+    QMutexLocker locker(&mutex);
+    frameWidth = width;
+    frameHeight = height;
+    framePitch = pitch;
+    this->nativeWidth = nativeWidth;
+    this->nativeHeight = nativeHeight;
+    latest = -1;
+    lastDisplay = -1;
+    averageInterval = 0;
+
+    auto create = [pitch, height]
+    {
+        Buffer* buffer = new Buffer;
+        buffer->data = static_cast<uchar*>(qMallocAligned(size_t(pitch) * height, BUFFER_ALIGNMENT));
+        // black until the first frame lands in it
+        std::memset(buffer->data, 0, size_t(pitch) * height);
+        buffer->pins.storeRelease(1);
+        return buffer;
+    };
+
+    for(Buffer*& buffer : buffers)
+        buffer = create();
+    spare = create();
+}
+
+void FramePool::release()
+{
+    QMutexLocker locker(&mutex);
+    latest = -1;
+
+    for(Buffer*& buffer : buffers)
+    {
+        if(buffer)
+            unpin(buffer);
+        buffer = nullptr;
+    }
+
+    if(spare)
+        unpin(spare);
+    spare = nullptr;
+}
+
+void FramePool::unpin(void *opaque)
+{
+    Buffer* buffer = static_cast<Buffer*>(opaque);
+    if(! buffer->pins.deref())
+    {
+        qFreeAligned(buffer->data);
+        delete buffer;
+    }
+}
+
+unsigned FramePool::formatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                   unsigned *pitches, unsigned *lines)
+{
+    FramePool* self = static_cast<FramePool*>(*opaque);
+
+    QSize maxSize;
+    {
+        QMutexLocker locker(&self->mutex);
+        maxSize = self->maxOutputSize;
+    }
+
+    // libvlc converts to RGB32 straight into the buffer, rows padded to the alignment. Video
+    // larger than any screen is scaled in the same pass, cheaper than converting every
+    // frame at full size only to have it scaled down when painted
+    QSize native(int(*width), int(*height));
+    QSize output = native;
+    if(maxSize.isValid() && (native.width() > maxSize.width() || native.height() > maxSize.height()))
+    {
+        output = native.scaled(maxSize, Qt::KeepAspectRatio);
+        output = QSize(qMax(2, output.width() & ~1), qMax(2, output.height() & ~1));
+    }
+
+    unsigned pitch = (unsigned(output.width()) * 4 + BUFFER_ALIGNMENT - 1) & ~unsigned(BUFFER_ALIGNMENT - 1);
+    std::memcpy(chroma, "RV32", 4);
+    *width = unsigned(output.width());
+    *height = unsigned(output.height());
+    *pitches = pitch;
+    *lines = *height;
+
+    self->allocate(output.width(), output.height(), int(pitch), native.width(), native.height());
+    return FRAME_POOL_SIZE;
+}
+
+void FramePool::cleanupCallback(void *opaque)
+{
+    static_cast<FramePool*>(opaque)->release();
+}
+
+void *FramePool::lockCallback(void *opaque, void **planes)
+{
+    FramePool* self = static_cast<FramePool*>(opaque);
+    QMutexLocker locker(&self->mutex);
+
+    // any buffer that is neither the one on show nor pinned by a consumer
+    Buffer* target = self->spare;
+    for(int i = 0; i < FRAME_POOL_SIZE; ++i)
+    {
+        if(i != self->latest && self->buffers[i]->pins.loadAcquire() == 1)
+        {
+            target = self->buffers[i];
+            break;
+        }
+    }
+
+    planes[0] = target->data;
+    return target;
+}
+
+void FramePool::unlockCallback(void *opaque, void *picture, void *const *planes)
+{
+    Q_UNUSED(opaque)
+    Q_UNUSED(picture)
+    Q_UNUSED(planes)
+}
+
+void FramePool::displayCallback(void *opaque, void *picture)
+{
+    FramePool* self = static_cast<FramePool*>(opaque);
+
+    {
+        QMutexLocker locker(&self->mutex);
+        if(picture == self->spare)
+        {
+            self->dropped.ref();
+            return;
+        }
+
+        for(int i = 0; i < FRAME_POOL_SIZE; ++i)
+        {
+            if(self->buffers[i] == picture)
+                self->latest = i;
+        }
+
+        qint64 now = self->displayClock.elapsed();
+        // a pause or a seek is not a frame interval
+        if(self->lastDisplay >= 0 && now - self->lastDisplay < MAX_FRAME_INTERVAL)
+        {
+            double interval = now - self->lastDisplay;
+            self->averageInterval = (self->averageInterval == 0) ? interval :
+                    self->averageInterval + INTERVAL_SMOOTHING * (interval - self->averageInterval);
+        }
+        self->lastDisplay = now;
+    }
+
+    if(self->updatePending.testAndSetOrdered(0, 1))
+    {
+        QMetaObject::invokeMethod(self, [self]
+        {
+            self->updatePending.storeRelease(0);
+            emit self->frameReady();
+        }, Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,98 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QMutex>
+
+class QPainter;
+class VlcMediaPlayer;
+
+const int FRAME_POOL_SIZE = 3;
+
+// Video of the main player rendered to memory through libvlc's callbacks.
+// FRAME_POOL_SIZE buffers, 64-byte aligned and allocated once per video
+// format, are written in turn by the video output. Consumers (the video
+// widget, snapshots, analyzers) get the latest frame as a read-only QImage
+// over the buffer itself; it pins the buffer until the last copy of the
+// image is gone, so nothing is copied or allocated per frame. When every
+// buffer is pinned the frame goes to a spare buffer and is dropped.
+// Video larger than the maximum output size is scaled down by libvlc while
+// it converts, frames are then not at the native size of the video.
+class FramePool : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FramePool(QObject *parent = nullptr);
+    ~FramePool();
+
+    void attach(VlcMediaPlayer* player);
+    QImage latestFrame() const;
+    int droppedFrames() const;
+    double frameInterval() const;
+    void setMaxOutputSize(const QSize& size);
+    bool isNativeSize() const;
+
+    static void paint(QPainter* painter, const QRect& area, const QImage& frame);
+
+signals:
+    // coalesced, at most one is queued however fast frames come
+    void frameReady();
+
+private:
+    struct Buffer
+    {
+        uchar* data;
+        // one pin is the pool's own, the buffer is freed when the last one goes
+        QAtomicInt pins;
+    };
+
+    static unsigned formatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                   unsigned *pitches, unsigned *lines);
+    static void cleanupCallback(void *opaque);
+    static void *lockCallback(void *opaque, void **planes);
+    static void unlockCallback(void *opaque, void *picture, void *const *planes);
+    static void displayCallback(void *opaque, void *picture);
+    static void unpin(void *buffer);
+
+    void allocate(int width, int height, int pitch, int nativeWidth, int nativeHeight);
+    void release();
+
+    mutable QMutex mutex;
+    Buffer* buffers[FRAME_POOL_SIZE];
+    Buffer* spare;
+    int latest;
+    int frameWidth;
+    int frameHeight;
+    int framePitch;
+    int nativeWidth;
+    int nativeHeight;
+    QSize maxOutputSize;
+    QElapsedTimer displayClock;
+    qint64 lastDisplay;
+    double averageInterval;
+    QAtomicInt updatePending;
+    QAtomicInt dropped;
+};
+
+#endif // FRAMEPOOL_H
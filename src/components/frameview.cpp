@@ -0,0 +1,106 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "frameview.h"
+#include "framepool.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+
+FrameView::FrameView(FramePool *pool, QWidget *parent)
+    : QWidget(parent),
+      pool(pool),
+      frameRateCap(0),
+      measuring(false)
+{
+    this->setMouseTracking(true);
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+    deferredUpdate.setSingleShot(true);
+    deferredUpdate.setTimerType(Qt::PreciseTimer);
+    connect(&deferredUpdate, &QTimer::timeout, this, [this] { this->update(); });
+    connect(pool, &FramePool::frameReady, this, &FrameView::onFrameReady);
+}
+
+void FrameView::startMeasuring()
+{
+    measuring = true;
+    switchTimer.start();
+    // the latest frame is already in the pool, no need to wait for the next one
+    this->update();
+}
+
+void FrameView::setMaxFrameRate(int fps)
+{
+    frameRateCap = qMax(0, fps);
+}
+
+int FrameView::maxFrameRate() const
+{
+    return frameRateCap;
+}
+
+void FrameView::onFrameReady()
+{
+    if(frameRateCap <= 0)
+    {
+        this->update();
+        return;
+    }
+
+    // frames in between are skipped, the one painted is always the latest
+    if(deferredUpdate.isActive())
+        return;
+
+    qint64 minimumInterval = 1000 / frameRateCap;
+    qint64 sinceLastPaint = lastPaint.isValid() ? lastPaint.elapsed() : minimumInterval;
+    if(sinceLastPaint >= minimumInterval)
+        this->update();
+    else
+        deferredUpdate.start(int(minimumInterval - sinceLastPaint));
+}
+
+void FrameView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter p(this);
+    QImage frame = pool->latestFrame();
+    if(frame.isNull())
+    {
+        p.fillRect(this->rect(), Qt::black);
+        return;
+    }
+
+    lastPaint.start();
+
+    // smooth-scaling a full-size frame into a small window costs far more than a few box filter passes
+    QSize pixelSize = this->size() * this->devicePixelRatioF();
+    FramePool::paint(&p, this->rect(), downscaler.downscale(frame, pixelSize));
+
+    if(measuring)
+    {
+        measuring = false;
+        emit firstFramePainted(switchTimer.nsecsElapsed() / 1000000.0);
+    }
+}
+
+void FrameView::mouseMoveEvent(QMouseEvent *event)
+{
+    event->ignore();
+    emit mouseMove();
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef FRAMEVIEW_H
+#define FRAMEVIEW_H
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "../framedownscaler.h"
+
+class FramePool;
+
+// A plain widget that shows the latest frame of a FramePool. It is a second
+// surface for the same decoded frames, so showing it never touches the
+// video output. After startMeasuring() the first painted frame reports how
+// long it took to get there. Frames are box-filtered down close to the
+// widget size before painting and the repaint rate can be capped. Both only
+// save painting: libvlc still decodes and converts every frame for the pool.
+class FrameView : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit FrameView(FramePool* pool, QWidget *parent = nullptr);
+
+    void startMeasuring();
+    void setMaxFrameRate(int fps);
+    int maxFrameRate() const;
+
+signals:
+    void mouseMove();
+    void firstFramePainted(double elapsed);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    void onFrameReady();
+
+    FramePool* pool;
+    FrameDownscaler downscaler;
+    QElapsedTimer switchTimer;
+    QElapsedTimer lastPaint;
+    QTimer deferredUpdate;
+    int frameRateCap;
+    bool measuring;
+};
+
+#endif // FRAMEVIEW_H
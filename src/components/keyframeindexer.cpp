@@ -0,0 +1,127 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "keyframeindexer.h"
+
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QDebug>
+#include <functional>
+
+#include "../tracer.h"
+
+class KeyframeScanTask : public QRunnable
+{
+public:
+    KeyframeScanTask(const QString& filePath, int generation, const QAtomicInt& latestGeneration,
+                     const std::function<void(const KeyframeIndex&)>& done)
+        : filePath(filePath),
+          generation(generation),
+          latestGeneration(latestGeneration),
+          done(done)
+    {
+    }
+
+    void run() override
+    {
+        // another file was opened in the meantime
+        if(latestGeneration.loadAcquire() != generation)
+            return;
+
+        TRACE_SCOPE("KeyframeIndexer::scan");
+        KeyframeIndex index;
+        if(KeyframeIndex::loadFromCache(filePath, &index))
+        {
+            done(index);
+            return;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QString error;
+        index = KeyframeIndex::scanMp4(filePath, &error);
+        if(! error.isEmpty())
+        {
+            qInfo() << "Keyframe index:" << filePath << "not indexed:" << error;
+            return;
+        }
+
+        qInfo() << "Keyframe index:" << index.size() << "keyframes in" << timer.elapsed() << "ms for" << filePath;
+        index.saveToCache(filePath);
+        done(index);
+    }
+
+private:
+    QString filePath;
+    int generation;
+    const QAtomicInt& latestGeneration;
+    std::function<void(const KeyframeIndex&)> done;
+};
+
+KeyframeIndexer::KeyframeIndexer(QObject *parent)
+    : QObject(parent),
+      generation(0)
+{
+    // one file at a time, and only while the user watches it
+    pool.setMaxThreadCount(1);
+}
+
+void KeyframeIndexer::index(const QString &filePath)
+{
+    clear();
+
+    if(! KeyframeIndex::isScannable(filePath))
+        return;
+
+    int requestGeneration = generation.loadAcquire();
+    auto done = [this, requestGeneration] (const KeyframeIndex& index)
+    {
+        QMetaObject::invokeMethod(this, [this, requestGeneration, index]
+        {
+            onScanned(requestGeneration, index);
+        });
+    };
+
+    pool.start(new KeyframeScanTask(filePath, requestGeneration, generation, done));
+}
+
+const KeyframeIndex &KeyframeIndexer::currentIndex() const
+{
+    return current;
+}
+
+void KeyframeIndexer::clear()
+{
+    generation.fetchAndAddOrdered(1);
+
+    if(! current.isEmpty())
+    {
+        current = KeyframeIndex();
+        emit indexChanged(current);
+    }
+}
+
+void KeyframeIndexer::onScanned(int requestGeneration, const KeyframeIndex &index)
+{
+    if(requestGeneration != generation.loadAcquire())
+        return;
+
+    current = index;
+    emit indexChanged(current);
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef KEYFRAMEINDEXER_H
+#define KEYFRAMEINDEXER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QThreadPool>
+
+#include "../keyframeindex.h"
+
+// Builds the keyframe index of the current file on a background thread,
+// or loads it from the disk cache. Only the result for the latest request
+// is delivered, older ones are dropped.
+class KeyframeIndexer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KeyframeIndexer(QObject *parent = nullptr);
+
+    void index(const QString& filePath);
+    const KeyframeIndex& currentIndex() const;
+
+signals:
+    void indexChanged(const KeyframeIndex& index);
+
+public slots:
+    void clear();
+
+private:
+    void onScanned(int generation, const KeyframeIndex& index);
+
+    KeyframeIndex current;
+    QAtomicInt generation;
+    QThreadPool pool; // declared last so its destructor waits for a running scan first
+};
+
+#endif // KEYFRAMEINDEXER_H
@@ -18,8 +18,6 @@
 
 #include "mainpage.h"
 #include <QtWidgets>
-#include <QtMultimedia>
-#include <QGraphicsVideoItem>
 #include <QtDebug>
 #include <QShortcut>
 #include <QTableWidget>
@@ -28,6 +26,12 @@
 
 #include "videoWidget.h"
 #include "../shared.h"
+#include "../mediaformats.h"
+#include "../stallwatchdog.h"
+#include "../tracer.h"
+#include "../vlcloader.h"
+#include "../startuptrace.h"
+#include "../timeformat.h"
 
 const int DOUBLE_CLICK_INTERVAL = 200;
 
@@ -47,17 +51,38 @@ MainPage::MainPage(QWidget *parent)
     mVideoWidget->setAutoFillBackground(false);
     mVideoWidget->setPalette(pal);
 
-    instance = new VlcInstance(this);
-    mPlayer = new VlcMediaPlayer(instance);
-    mPlayer->setPlaybackRate(1);
-    mPlayer->setVideoWidget(mVideoWidget->winId());
+    // the render path is fixed for the lifetime of the player, without the frame
+    // pool the surface exists before libvlc so picture-in-picture can take it anytime
+    mRenderThroughFramePool = Settings.renderThroughFramePool();
+    mVideoSurface = mRenderThroughFramePool ? nullptr : mVideoWidget->createSurface();
+    videoViewEvent = false;
+    if(mVideoSurface)
+        watchVideoView(mVideoSurface);
+
+    mPerformanceProfile = PerformanceProfile::fromInt(Settings.performanceProfile());
+    mInstanceProfile = mPerformanceProfile;
+    fastStart = Settings.fastStart();
+    idle = true;
+    videoVisible = true;
+    reopening = false;
+    inputReopened = false;
+
+    // everything built on libvlc waits for it to be loaded, see setupPlayer()
+    instance = nullptr;
+    mPlayer = nullptr;
+    mFramePool = nullptr;
+    mSeekScheduler = nullptr;
+    mBackgroundAudioMode = nullptr;
+    mFirstFrameTimer = nullptr;
+    mKeyframeIndexer = nullptr;
+    mThumbnailProvider = nullptr;
+    mSnapshotPipeline = nullptr;
+    mStatsSampler = nullptr;
+    mDecodeQualityGovernor = nullptr;
 
     setAcceptDrops(true);
     mPlayerController = new PlayerController;
-    mPlayerController->setMediProgressSliderMediaPlayer(mPlayer);
     setPlaylistMode(mPlayerController->loopOption());
-    mPlayer->setVolume(mPlayerController->mediaVolume());
-    mPlayer->setMute(mPlayerController->isMuted());
 
     playlist = new PlaylistPage;
     playlist->setRandom(mPlayerController->isRandom());
@@ -69,19 +94,8 @@ MainPage::MainPage(QWidget *parent)
     layout->setSpacing(0);
     setLayout(layout);
 
-    connect(mPlayer, &VlcMediaPlayer::stateChanged, this, [this] { mPlayerController->mediaStateChanged(mPlayer->state()); });
-    connect(mPlayer, &VlcMediaPlayer::stateChanged, this, [this] { emit mediaStateChanged(mPlayer->state()); });
-    connect(mPlayer, &VlcMediaPlayer::stopped, this, [this] { emit mediaChanged(""); emit setFullScreen(false); });
-    connect(mPlayer, &VlcMediaPlayer::end, this, &MainPage::onEndOfMedia);
-    connect(mPlayer, &VlcMediaPlayer::mediaChanged, chapterListPage, &ChapterListPage::unsetChapters);
-    connect(mPlayer, &VlcMediaPlayer::stopped, chapterListPage, &ChapterListPage::unsetChapters);
-    connect(mPlayerController, &PlayerController::play, mPlayer, &VlcMediaPlayer::play);
     connect(mPlayerController, &PlayerController::playWithNoMedia, this, &MainPage::play);
-    connect(mPlayerController, &PlayerController::pause, mPlayer, &VlcMediaPlayer::pause);
-    connect(mPlayerController, &PlayerController::stop, mPlayer, &VlcMediaPlayer::stop);
     connect(mPlayerController, &PlayerController::stop, mVideoWidget,[this]{ mVideoWidget->update();});
-    connect(mPlayerController, &PlayerController::muteVolume, mPlayer,&VlcMediaPlayer::setMute);
-    connect(mPlayerController, &PlayerController::volumeChanged, mPlayer,&VlcMediaPlayer::setVolume);
     connect(mPlayerController, &PlayerController::seekForward, this, [this] { jumpForward(10); });
     connect(mPlayerController, &PlayerController::seekBackward, this,  [this] { jumpBackward(10); });
     connect(mPlayerController, &PlayerController::next, this, &MainPage::next);
@@ -105,7 +119,131 @@ MainPage::MainPage(QWidget *parent)
     connect(chapterListPage, &ChapterListPage::videoTimeSynced, mPlayerController, &PlayerController::syncToVideoTime);
     connect(chapterListPage, &ChapterListPage::clearChapters, mPlayerController->mediaProgressSlider(), &MediaProgressSlider::unSetChapters);
 
+    VlcLoader* loader = VlcLoader::instance();
+    if(loader && ! loader->isReady())
+        connect(loader, &VlcLoader::ready, this, &MainPage::setupPlayer);
+    else
+        setupPlayer();
+}
+
+void MainPage::setupPlayer()
+{
+    // without a loader running, or when it has nothing to hand over, libvlc is loaded right here
+    VlcLoader* loader = VlcLoader::instance();
+    if(! loader || ! loader->take(&instance, &mPlayer))
+    {
+        instance = new VlcInstance(PerformanceProfile::instanceArguments(mInstanceProfile));
+        StartupTrace::mark("vlc instance created");
+        mPlayer = new VlcMediaPlayer(instance);
+    }
+    instance->setParent(this);
+
+    mPlayer->setPlaybackRate(1);
+    if(mRenderThroughFramePool)
+    {
+        mFramePool = new FramePool(this);
+        // nothing is ever shown larger than the largest screen
+        QSize largestScreen;
+        for(QScreen* screen : QGuiApplication::screens())
+            largestScreen = largestScreen.expandedTo(screen->size() * screen->devicePixelRatio());
+        mFramePool->setMaxOutputSize(largestScreen);
+        mFramePool->attach(mPlayer);
+        mVideoWidget->setFramePool(mFramePool);
+    }
+    else
+    {
+        mPlayer->setVideoWidget(mVideoSurface->winId());
+        connect(mPlayer, &VlcMediaPlayer::vout, mVideoWidget, [this] (int count) { mVideoWidget->setVideoOutput(count > 0); });
+        connect(mPlayer, &VlcMediaPlayer::stopped, mVideoWidget, [this] { mVideoWidget->setVideoOutput(false); });
+    }
+
+    mPlayerController->setMediProgressSliderMediaPlayer(mPlayer);
+    mSeekScheduler = new SeekScheduler(mPlayer, this);
+    mPlayerController->mediaProgressSlider()->setSeekScheduler(mSeekScheduler);
+    mBackgroundAudioMode = new BackgroundAudioMode(mPlayer, mSeekScheduler, this);
+    mBackgroundAudioMode->setEnabled(Settings.backgroundAudioOnly());
+    mBackgroundAudioMode->setVideoVisible(videoVisible);
+    mFirstFrameTimer = new FirstFrameTimer(mPlayer, this);
+    mKeyframeIndexer = new KeyframeIndexer(this);
+    connect(mKeyframeIndexer, &KeyframeIndexer::indexChanged, mPlayerController->mediaProgressSlider(), &MediaProgressSlider::setKeyframeIndex);
+    mThumbnailProvider = new ThumbnailProvider(instance, this);
+    connect(mKeyframeIndexer, &KeyframeIndexer::indexChanged, mThumbnailProvider, &ThumbnailProvider::setKeyframeIndex);
+    mPlayerController->mediaProgressSlider()->setThumbnailProvider(mThumbnailProvider);
+    mSnapshotPipeline = new SnapshotPipeline(instance, this);
+    mSnapshotPipeline->setFormat(Settings.snapshotFormat());
+    mSnapshotPipeline->setCopyToClipboard(Settings.copySnapshotsToClipboard());
+    mSnapshotPipeline->setOutputFolder(Settings.snapshotFolder());
+    connect(mSnapshotPipeline, &SnapshotPipeline::snapshotSaved, this, [this] (const QString& filePath, qint64 latency)
+    {
+        qInfo() << "Snapshot:" << filePath << "saved" << latency << "ms after the request";
+        emit message(QString("Snapshot saved (%1 ms)").arg(latency));
+    });
+    connect(mSnapshotPipeline, &SnapshotPipeline::snapshotFailed, this, [this] { emit message("Snapshot failed", true); });
+    mPlayer->setVolume(mPlayerController->mediaVolume());
+    mPlayer->setMute(mPlayerController->isMuted());
+
+    mStatsSampler = new PlaybackStatsSampler(mPlayer, this);
+    mStatsSampler->setInterval(Settings.statsSamplingInterval());
+    mDecodeQualityGovernor = new DecodeQualityGovernor(mPlayer, this);
+    mDecodeQualityGovernor->setBaselineOptions(PerformanceProfile::mediaOptions(mPerformanceProfile));
+
+    connect(mPlayer, &VlcMediaPlayer::stateChanged, this, [this] { mPlayerController->mediaStateChanged(mPlayer->state()); });
+    connect(mPlayer, &VlcMediaPlayer::stateChanged, this, [this] { emit mediaStateChanged(mPlayer->state()); });
+    connect(mPlayer, &VlcMediaPlayer::stopped, this, [this] { emit mediaChanged(""); emit setFullScreen(false); });
+    connect(mPlayer, &VlcMediaPlayer::end, this, &MainPage::onEndOfMedia);
+    connect(mPlayer, &VlcMediaPlayer::mediaChanged, mStatsSampler, &PlaybackStatsSampler::resetCounters);
+    connect(mPlayer, &VlcMediaPlayer::stateChanged, this, &MainPage::updateIdle);
+    if(StartupTrace::isEnabled())
+    {
+        connect(mPlayer, &VlcMediaPlayer::vout, this, [] (int count)
+        {
+            if(count > 0)
+            {
+                StartupTrace::mark("first frame");
+                StartupTrace::finish();
+            }
+        });
+    }
+    // libvlc events, traced on the libvlc thread that raises them
+    connect(mPlayer, &VlcMediaPlayer::opening, this, [] { Tracer::instant("libvlc opening"); }, Qt::DirectConnection);
+    connect(mPlayer, &VlcMediaPlayer::playing, this, [] { Tracer::asyncEnd("media open", 0); }, Qt::DirectConnection);
+    connect(mPlayer, &VlcMediaPlayer::vout, this, [] (int count)
+    {
+        if(count > 0)
+            Tracer::instant("libvlc first frame");
+    }, Qt::DirectConnection);
+    connect(mPlayer, &VlcMediaPlayer::end, this, [] { Tracer::instant("libvlc end of media"); }, Qt::DirectConnection);
+    connect(mPlayer, &VlcMediaPlayer::error, this, [] { Tracer::asyncEnd("media open", 0); Tracer::instant("libvlc error"); }, Qt::DirectConnection);
+    // sprite sheets are only built while nothing plays, and once the file is known to have video
+    connect(mPlayer, &VlcMediaPlayer::stateChanged, this, [this] { mThumbnailProvider->setIdle(mPlayer->state() != Vlc::Playing); });
+    connect(mPlayer, &VlcMediaPlayer::vout, this, [this] (int count)
+    {
+        if(count > 0)
+            onFirstFrame();
+    });
+    connect(mThumbnailProvider, &ThumbnailProvider::spriteSheetChanged, this, &MainPage::updateChapterThumbnails);
+    connect(mPlayer, &VlcMediaPlayer::mediaChanged, mBackgroundAudioMode, &BackgroundAudioMode::reset);
+    connect(mPlayer, &VlcMediaPlayer::playing, mBackgroundAudioMode, &BackgroundAudioMode::onPlaybackStarted);
+    connect(mPlayer, &VlcMediaPlayer::mediaChanged, this, &MainPage::onPlayerMediaChanged);
+    connect(mDecodeQualityGovernor, &DecodeQualityGovernor::reopenRequested, this, &MainPage::reopenCurrentMedia);
+    connect(mStatsSampler, &PlaybackStatsSampler::sampled, mDecodeQualityGovernor, &DecodeQualityGovernor::onSample);
+    connect(mPlayer, &VlcMediaPlayer::stopped, chapterListPage, &ChapterListPage::unsetChapters);
+    connect(mPlayerController, &PlayerController::play, mPlayer, &VlcMediaPlayer::play);
+    connect(mPlayerController, &PlayerController::pause, mPlayer, &VlcMediaPlayer::pause);
+    connect(mPlayerController, &PlayerController::stop, mPlayer, &VlcMediaPlayer::stop);
+    connect(mPlayerController, &PlayerController::muteVolume, mPlayer,&VlcMediaPlayer::setMute);
+    connect(mPlayerController, &PlayerController::volumeChanged, mPlayer,&VlcMediaPlayer::setVolume);
+
     setupShortcuts();
+    emit playerReady();
+
+    // a file opened while libvlc was loading, e.g. the one from the command line
+    if(! pendingFile.filePath().isEmpty())
+    {
+        QFileInfo file = pendingFile;
+        pendingFile = QFileInfo();
+        playFile(file);
+    }
 }
 
 void MainPage::setupShortcuts()
@@ -198,6 +336,7 @@ void MainPage::setupShortcuts()
             if(sub > mPlayer->subtitleCount())
                 sub = -1;
 
+            TRACE_SCOPE("subtitle track switch");
             if(sub == -1)
                 emit message("Subtitle track: N/A");
             else
@@ -241,10 +380,16 @@ void MainPage::setupShortcuts()
     {
         playerController()->clickPicInPicButton();
     });
+
+    // this page stays in the hidden main window during picture-in-picture,
+    // the shortcuts have to reach it from the picture-in-picture window too
+    for(QShortcut* shortcut : findChildren<QShortcut*>(QString(), Qt::FindDirectChildrenOnly))
+        shortcut->setContext(Qt::ApplicationShortcut);
 }
 
 void MainPage::checkForChapterFile(QString filePath)
 {
+    STALL_MARKER("MainPage::checkForChapterFile");
     QString fileTxt = filePath + ".txt";
     QString fileCh = filePath + ".ch";
     if(QFile::exists(fileTxt))
@@ -259,6 +404,8 @@ void MainPage::checkForChapterFile(QString filePath)
 
 void MainPage::addChapterFile(const QString &filePath)
 {
+    STALL_MARKER("MainPage::addChapterFile");
+    TRACE_SCOPE("MainPage::addChapterFile");
     QFile file(filePath);
     if(file.open(QIODevice::ReadOnly | QIODevice::Text))
     {
@@ -269,6 +416,8 @@ void MainPage::addChapterFile(const QString &filePath)
 
 void MainPage::processChaptersText(QString text)
 {
+    STALL_MARKER("MainPage::processChaptersText");
+    TRACE_SCOPE("MainPage::processChaptersText");
     QStringList lines = text.split("\n", Qt::SkipEmptyParts);
 
     // ignore lines starting with ';'
@@ -280,6 +429,10 @@ void MainPage::processChaptersText(QString text)
         }
     }
 
+    // compiled once for the whole file, not once per line
+    const QRegularExpression timestampRegex("(?:[^a-zA-Z0-9_=:])((?:(\\d{1,2}):)?(\\d{1,2}):(\\d{1,2}))(?:[^a-zA-Z0-9_=:])?");
+    const QRegularExpression deletionRE("^[^a-zA-Z0-9!'\"_`\\[{(\\?]*|[^a-zA-Z0-9!)'\"_`}\\]\\.\\?]*$");
+
     QStringList chapters;
     QList<qint64> timestamps;
     for(int i = 0; i < lines.size(); ++i)
@@ -287,15 +440,10 @@ void MainPage::processChaptersText(QString text)
         QString line = lines.at(i);
         line.prepend(' '); // force timestamp capture when they are at the beginning of the line
 
-        QRegularExpression timestampRegex("(?:[^a-zA-Z0-9_=:])((?:(\\d{1,2}):)?(\\d{1,2}):(\\d{1,2}))(?:[^a-zA-Z0-9_=:])?");
-        QRegularExpression deletionRE("^[^a-zA-Z0-9!'\"_`\\[{(\\?]*|[^a-zA-Z0-9!)'\"_`}\\]\\.\\?]*$");
         QRegularExpressionMatch match = timestampRegex.match(line);
 
         if(match.hasMatch())
         {
-            int hours   =  match.captured(2).isEmpty() ? 0 : match.captured(2).toInt();
-            int minutes =  match.captured(3).isEmpty() ? 0 : match.captured(3).toInt();
-            int seconds  = match.captured(4).isEmpty() ? 0 : match.captured(4).toInt();
             QString chapterTitle;
 
             QString part1 = line.mid(0, line.indexOf(match.captured(1)));
@@ -311,9 +459,9 @@ void MainPage::processChaptersText(QString text)
 
             chapterTitle.remove(deletionRE);
 
-            double milliseconds = ((hours * 3600000) + (minutes * 60000) + (seconds * 1000));
+            qint64 milliseconds = parseTime(match.captured(1));
 
-            if(milliseconds == 0.0)
+            if(milliseconds == 0)
             {
                 timestamps.clear();
                 chapters.clear();
@@ -348,11 +496,25 @@ void MainPage::processChaptersText(QString text)
         {
             mPlayerController->mediaProgressSlider()->setChapters(chapters, timestamps);
             chapterListPage->setChapters(chapters, timestamps);
+            updateChapterThumbnails();
             emit message("Chapter list added");
         }
     }
 }
 
+void MainPage::updateChapterThumbnails()
+{
+    // without a sprite sheet every chapter would be a live grab, the list can do without
+    if(! mThumbnailProvider->hasSpriteSheet())
+        return;
+
+    QList<QImage> thumbnails;
+    for(qint64 time : chapterListPage->chapterTimestamps())
+        thumbnails.append(mThumbnailProvider->thumbnail(time));
+
+    chapterListPage->setChapterThumbnails(thumbnails);
+}
+
 void MainPage::copyFromClipboard()
 {
     const QMimeData *mimeData = clipboard->mimeData();
@@ -365,14 +527,21 @@ void MainPage::copyFromClipboard()
 
 void MainPage::addSubtiles(const QList<QUrl> &urls)
 {
+    STALL_MARKER("MainPage::addSubtiles");
+    TRACE_SCOPE("MainPage::addSubtiles");
     for(auto const& subtitle : urls)
+    {
         mPlayer->setSubtitleFile(subtitle.toString());
+        addedSubtitleFiles << subtitle.toString();
+    }
 
     emit message("Subtitle track added");
 }
 
 void MainPage::openFiles(const QList<QUrl> &urls, bool play)
 {
+    STALL_MARKER("MainPage::openFiles");
+    TRACE_SCOPE("MainPage::openFiles");
     playlist->addFiles(filterSupportedMediaFormats(urls), play);
 }
 
@@ -380,8 +549,26 @@ void MainPage::takeSnapshot()
 {
     if(isPlayerSeekable())
     {
-        mPlayer->takeSnapshot(playlist->currentFilePlayingPath() + "-" +
-                              QDateTime::currentDateTime().toString(Qt::ISODateWithMs).remove(":") + ".jpg");
+        // a snapshot is taken at the native size of the video
+        QImage frame = (mFramePool && mFramePool->isNativeSize()) ? mFramePool->latestFrame() : QImage();
+        if(! frame.isNull())
+            mSnapshotPipeline->takeFrame(playlist->currentFilePlayingPath(), frame);
+        else
+            mSnapshotPipeline->take(playlist->currentFilePlayingPath(), mPlayer->time());
+    }
+}
+
+void MainPage::takeSnapshotBurst()
+{
+    if(isPlayerSeekable())
+    {
+        // while playing the pool already holds every frame of the burst, paused it would repeat one
+        if(mFramePool && mFramePool->isNativeSize() && mPlayer->state() == Vlc::Playing)
+            mSnapshotPipeline->takeBurst(playlist->currentFilePlayingPath(), mFramePool,
+                                         Settings.snapshotBurstCount(), Settings.snapshotBurstInterval());
+        else
+            mSnapshotPipeline->take(playlist->currentFilePlayingPath(), mPlayer->time(),
+                                    Settings.snapshotBurstCount(), Settings.snapshotBurstInterval());
     }
 }
 
@@ -389,12 +576,20 @@ void MainPage::setPlayerTime(qint64 time)
 {
     if(isPlayerSeekable())
     {
-        mPlayer->setTime(time);
+        mSeekScheduler->seekTo(time);
     }
 }
 
+bool MainPage::isPlayerReady() const
+{
+    return mPlayer != nullptr;
+}
+
 bool MainPage::isPlayerSeekable()
 {
+    if(! mPlayer)
+        return false;
+
     Vlc::State playerState = mPlayer->state();
     return (playerState == Vlc::Playing || playerState == Vlc::Paused || playerState == Vlc::Opening);
 }
@@ -424,15 +619,263 @@ VlcMediaPlayer *MainPage::player() const
     return mPlayer;
 }
 
+PlaybackStatsSampler *MainPage::statsSampler() const
+{
+    return mStatsSampler;
+}
+
+DecodeQualityGovernor *MainPage::decodeQualityGovernor() const
+{
+    return mDecodeQualityGovernor;
+}
+
+SeekScheduler *MainPage::seekScheduler() const
+{
+    return mSeekScheduler;
+}
+
+SnapshotPipeline *MainPage::snapshotPipeline() const
+{
+    return mSnapshotPipeline;
+}
+
+FramePool *MainPage::framePool() const
+{
+    return mFramePool;
+}
+
+bool MainPage::rendersThroughFramePool() const
+{
+    return mRenderThroughFramePool;
+}
+
+BackgroundAudioMode *MainPage::backgroundAudioMode() const
+{
+    return mBackgroundAudioMode;
+}
+
+bool MainPage::isIdle() const
+{
+    return idle;
+}
+
+void MainPage::setVideoVisible(bool visible)
+{
+    videoVisible = visible;
+    if(mBackgroundAudioMode)
+        mBackgroundAudioMode->setVideoVisible(visible);
+    updateIdle();
+}
+
+void MainPage::updateIdle()
+{
+    // idle is when nothing changes on screen: nothing plays, or nobody can see it
+    bool nowIdle = ! mPlayer || mPlayer->state() != Vlc::Playing || ! videoVisible;
+    if(nowIdle == idle)
+        return;
+
+    idle = nowIdle;
+
+    // polling only makes sense while frames are flowing, everything else waits for events
+    if(idle)
+        mStatsSampler->stop();
+    else
+        mStatsSampler->start();
+
+    emit idleChanged(idle);
+}
+
+void MainPage::onFirstFrame()
+{
+    // the work for the first frame was done before the governor reopened the file
+    if(inputReopened)
+        return;
+
+    if(! deferredMediaPath.isEmpty())
+    {
+        mKeyframeIndexer->index(deferredMediaPath);
+        addMatchingSubtitles(deferredMediaPath);
+        deferredMediaPath.clear();
+    }
+
+    mThumbnailProvider->generateSpriteSheet(mPlayer->length());
+}
+
+// stands in for libvlc's subtitle autodetection, which fast start turns off
+void MainPage::addMatchingSubtitles(const QString &filePath)
+{
+    QFileInfo media(filePath);
+    QString base = media.absolutePath() + "/" + media.completeBaseName() + ".";
+
+    for(const QString& extension : MediaFormats::extensions(MediaFormats::SUBTITLE))
+    {
+        if(QFile::exists(base + extension))
+        {
+            mPlayer->setSubtitleFile(QUrl::fromLocalFile(base + extension).toString());
+            addedSubtitleFiles << QUrl::fromLocalFile(base + extension).toString();
+        }
+    }
+}
+
+void MainPage::onPlayerMediaChanged()
+{
+    // the same file opened again keeps its chapters and the governor level
+    if(reopening)
+    {
+        reopening = false;
+        inputReopened = true;
+        return;
+    }
+
+    inputReopened = false;
+    addedSubtitleFiles.clear();
+    mDecodeQualityGovernor->reset();
+    chapterListPage->unsetChapters();
+    mPlayerController->mediaProgressSlider()->unSetChapters();
+}
+
+// libvlc copies the media options into the input only when it creates it,
+// new decoder options need a new input, started where the old one was
+void MainPage::reopenCurrentMedia()
+{
+    STALL_MARKER("MainPage::reopenCurrentMedia");
+    TRACE_SCOPE("MainPage::reopenCurrentMedia");
+
+    VlcMedia* current = mPlayer->currentMedia();
+    Vlc::State state = mPlayer->state();
+    if(! current || (state != Vlc::Playing && state != Vlc::Paused))
+        return;
+
+    QStringList options = mDecodeQualityGovernor->mediaOptions();
+    options << QString(":start-time=%1").arg(mPlayer->time() / 1000.0, 0, 'f', 3);
+    qInfo() << "Decode governor: reopening with" << options.join(' ');
+
+    VlcMedia* media = new VlcMedia(current->currentLocation(), true, instance);
+    media->setOptions(options);
+    reopening = true;
+    mPlayer->setMedia(media);
+    mPlayer->play();
+    current->deleteLater();
+
+    // subtitle files belong to the old input, they go on the new one once it runs
+    bool paused = (state == Vlc::Paused);
+    disconnect(reopenedConnection);
+    reopenedConnection = connect(mPlayer, &VlcMediaPlayer::playing, this, [this, paused]
+    {
+        disconnect(reopenedConnection);
+        for(const QString& subtitle : qAsConst(addedSubtitleFiles))
+            mPlayer->setSubtitleFile(subtitle);
+        if(paused)
+            mPlayer->pause();
+    });
+}
+
+PerformanceProfile::Profile MainPage::performanceProfile() const
+{
+    return mPerformanceProfile;
+}
+
+void MainPage::setPerformanceProfile(PerformanceProfile::Profile profile)
+{
+    if(profile == mPerformanceProfile)
+        return;
+
+    mPerformanceProfile = profile;
+    Settings.setPerformanceProfile(profile);
+    if(mDecodeQualityGovernor)
+        mDecodeQualityGovernor->setBaselineOptions(PerformanceProfile::mediaOptions(profile));
+
+    qInfo() << "Performance profile:" << PerformanceProfile::name(profile) << PerformanceProfile::mediaOptions(profile);
+
+    if(profile == mInstanceProfile)
+        emit message(PerformanceProfile::name(profile));
+    else
+        emit message(PerformanceProfile::name(profile) + tr(" (fully applied after restart)"));
+}
+
+FirstFrameTimer *MainPage::firstFrameTimer() const
+{
+    return mFirstFrameTimer;
+}
+
+bool MainPage::isFastStart() const
+{
+    return fastStart;
+}
+
+void MainPage::setFastStart(bool enabled)
+{
+    fastStart = enabled;
+    Settings.setFastStart(enabled);
+}
+
+QString MainPage::effectivePerformanceOptions() const
+{
+    // the media options follow the selected profile from the next file on,
+    // the instance keeps the arguments it was created with
+    QString options = tr("Profile: %1\nInstance: %2\nMedia: %3")
+            .arg(PerformanceProfile::name(mPerformanceProfile),
+                 PerformanceProfile::instanceArguments(mInstanceProfile).join(' '),
+                 PerformanceProfile::mediaOptions(mPerformanceProfile).join(' '));
+
+    if(fastStart)
+        options += tr("\nFast start: %1").arg(PerformanceProfile::fastStartOptions(mPerformanceProfile).join(' '));
+
+    if(mInstanceProfile != mPerformanceProfile)
+        options += tr("\n\nInstance arguments of \"%1\" apply after restart: %2")
+                .arg(PerformanceProfile::name(mPerformanceProfile),
+                     PerformanceProfile::instanceArguments(mPerformanceProfile).join(' '));
+
+    return options;
+}
+
 void MainPage::playFile(const QFileInfo &file)
 {
+    STALL_MARKER("MainPage::playFile");
+    TRACE_SCOPE("MainPage::playFile");
+
+    if(! mPlayer)
+    {
+        pendingFile = file;
+        return;
+    }
+
     if(! file.filePath().isEmpty())
     {
         if(QFile::exists(file.filePath()))
         {
+            mFirstFrameTimer->start(file.fileName(), fastStart);
+            Tracer::asyncBegin("media open", 0);
+
+            QStringList options = PerformanceProfile::mediaOptions(mPerformanceProfile);
+            if(fastStart)
+                options << PerformanceProfile::fastStartOptions(mPerformanceProfile);
+
             VlcMedia* _media = new VlcMedia(file.filePath(), true, instance);
-            mPlayer->setMedia(_media);
-            mPlayer->play();
+            _media->setOptions(options);
+            {
+                STALL_MARKER("VlcMediaPlayer::setMedia");
+                TRACE_SCOPE("VlcMediaPlayer::setMedia");
+                mPlayer->setMedia(_media);
+            }
+            mThumbnailProvider->setMedia(file.filePath());
+
+            // fast start keeps the disk to the player until the first frame is out
+            deferredMediaPath.clear();
+            if(fastStart)
+            {
+                mKeyframeIndexer->clear();
+                deferredMediaPath = file.filePath();
+            }
+            else
+            {
+                mKeyframeIndexer->index(file.filePath());
+            }
+            {
+                STALL_MARKER("VlcMediaPlayer::play");
+                TRACE_SCOPE("VlcMediaPlayer::play");
+                mPlayer->play();
+            }
 
             QTimer::singleShot(500, this, [this, file]
             {
@@ -477,6 +920,9 @@ void MainPage::decreaseVolume()
 
 void MainPage::play()
 {
+    if(! mPlayer)
+        return;
+
     if(mPlayer->state() == Vlc::Idle or mPlayer->state() == Vlc::Ended)
     {
         if(! playlist->isEmpty())
@@ -486,6 +932,7 @@ void MainPage::play()
 
 void MainPage::pause()
 {
+    STALL_MARKER("VlcMediaPlayer::pause");
     mPlayer->pause();
 }
 
@@ -501,37 +948,18 @@ void MainPage::previous()
 
 void MainPage::jumpForward(int sec)
 {
-    if(isPlayerSeekable())
+    // relative to the pending seek target, so quick repeated presses add up
+    if(isPlayerSeekable() && sec > 0)
     {
-        if(sec > 0)
-        {
-            qint64 currentTime = mPlayer->time();
-            qint64 time =  currentTime + (sec * 1000);
-
-            if(time > mPlayerController->mediaProgressSlider()->mediaLength())
-            {
-                time = mPlayerController->mediaProgressSlider()->mediaLength();
-            }
-            mPlayer->setTime(time);
-        }
+        mSeekScheduler->seekBy(sec * 1000);
     }
 }
 
 void MainPage::jumpBackward(int sec)
 {
-    if(isPlayerSeekable())
+    if(isPlayerSeekable() && sec > 0)
     {
-        if(sec > 0)
-        {
-            qint64 currentTime = mPlayer->time();
-            qint64 time =  currentTime - (sec * 1000);
-
-            if(time < 0)
-            {
-                time = 0;
-            }
-            mPlayer->setTime(time);
-        }
+        mSeekScheduler->seekBy(-sec * 1000);
     }
 }
 
@@ -569,6 +997,14 @@ void MainPage::onEndOfMedia()
 
 void MainPage::resetPlayer()
 {
+    STALL_MARKER("MainPage::resetPlayer");
+    TRACE_SCOPE("MainPage::resetPlayer");
+    if(! mPlayer)
+    {
+        pendingFile = QFileInfo();
+        return;
+    }
+
     playerController()->clickStopButton(); // clear the view
     mPlayer->setMedia(nullptr);
     playerController()->mediaStateChanged(mPlayer->state());
@@ -577,7 +1013,7 @@ void MainPage::resetPlayer()
 void MainPage::onJumpToChapter(qint64 time)
 {
     // BUG:if it comes here when the video is paused, on play it will be go one second back and continue
-    mPlayer->setTime(time);
+    mSeekScheduler->seekTo(time);
     mPlayerController->mediaProgressSlider()->updatePostionIfPlayerPaused();
 }
 
@@ -626,7 +1062,7 @@ void MainPage::wheelEvent(QWheelEvent *event)
     if(! mPlayerController->shouldAllowWheelEventOperation() || ! mPlayer)
         return;
 
-    if( mVideoWidget->underMouse() && ! isPlayerSeekable() )
+    if( isVideoUnderMouse() && ! isPlayerSeekable() )
         return;
 
     if (event->angleDelta().y() > 0)
@@ -638,7 +1074,7 @@ void MainPage::wheelEvent(QWheelEvent *event)
 void MainPage::mouseDoubleClickEvent(QMouseEvent *event)
 {
     clickElapsedTimer.start();
-    if(mVideoWidget->underMouse() && event->button() == Qt::LeftButton)
+    if(isVideoUnderMouse() && event->button() == Qt::LeftButton)
     {
         if(isPlayerSeekable())
         {
@@ -689,6 +1125,48 @@ void MainPage::mousePressEvent(QMouseEvent *event)
         rightMouseButtonPressed = true;
 }
 
+// Clicks and wheel turns on a view of the video that is not a child of this
+// page, the native surface or the picture-in-picture frame view, are handled
+// as if they were on the page.
+void MainPage::watchVideoView(QObject *view)
+{
+    view->installEventFilter(this);
+}
+
+bool MainPage::eventFilter(QObject *watched, QEvent *event)
+{
+    if(watched == this)
+        return QWidget::eventFilter(watched, event);
+
+    bool handled = true;
+    videoViewEvent = true;
+    switch(event->type())
+    {
+    case QEvent::MouseButtonPress:
+        mousePressEvent(static_cast<QMouseEvent*>(event));
+        break;
+    case QEvent::MouseButtonRelease:
+        mouseReleaseEvent(static_cast<QMouseEvent*>(event));
+        break;
+    case QEvent::MouseButtonDblClick:
+        mouseDoubleClickEvent(static_cast<QMouseEvent*>(event));
+        break;
+    case QEvent::Wheel:
+        wheelEvent(static_cast<QWheelEvent*>(event));
+        break;
+    default:
+        handled = false;
+    }
+    videoViewEvent = false;
+
+    return handled || QWidget::eventFilter(watched, event);
+}
+
+bool MainPage::isVideoUnderMouse() const
+{
+    return videoViewEvent || mVideoWidget->containsMouse();
+}
+
 void MainPage::testFunction()
 {
     qDebug() << mPlayer->state();
@@ -24,6 +24,7 @@
 #include <QElapsedTimer>
 
 class VideoWidget;
+class VideoSurface;
 class QStackedWidget;
 class QTableWidget;
 
@@ -31,6 +32,15 @@ class QTableWidget;
 #include "playercontroller.h"
 #include "playlistpage.h"
 #include "chapterlistpage.h"
+#include "playbackstats.h"
+#include "decodequalitygovernor.h"
+#include "performanceprofile.h"
+#include "seekscheduler.h"
+#include "keyframeindexer.h"
+#include "thumbnailprovider.h"
+#include "snapshotpipeline.h"
+#include "backgroundaudiomode.h"
+#include "firstframetimer.h"
 
 class MainPage : public QWidget
 {
@@ -38,16 +48,34 @@ class MainPage : public QWidget
 public:
     explicit MainPage(QWidget *parent = nullptr);
 
+    bool isPlayerReady() const;
     bool isPlayerSeekable();
+    bool isIdle() const;
+    void setVideoVisible(bool visible);
     VideoWidget* videoWidget() const;
     PlaylistPage *playlistPage() const;
     ChapterListPage *chpaterPage() const;
     PlayerController* playerController() const;
     VlcMediaPlayer * player() const;
+    PlaybackStatsSampler* statsSampler() const;
+    DecodeQualityGovernor* decodeQualityGovernor() const;
+    SeekScheduler* seekScheduler() const;
+    SnapshotPipeline* snapshotPipeline() const;
+    FramePool* framePool() const;
+    bool rendersThroughFramePool() const;
+    BackgroundAudioMode* backgroundAudioMode() const;
+    FirstFrameTimer* firstFrameTimer() const;
+    bool isFastStart() const;
+    void setFastStart(bool enabled);
+    PerformanceProfile::Profile performanceProfile() const;
+    void setPerformanceProfile(PerformanceProfile::Profile profile);
+    QString effectivePerformanceOptions() const;
     void addSubtiles(const QList<QUrl> &urls);
     void openFiles(const QList<QUrl>& urls, bool play);
     void takeSnapshot();
+    void takeSnapshotBurst();
     void setPlayerTime(qint64 time);
+    void watchVideoView(QObject* view);
 
     void testFunction();
 
@@ -62,6 +90,8 @@ signals:
     void mouseMove();
     void message(QString, bool = false);
     void mediaStateChanged(Vlc::State state);
+    void idleChanged(bool idle);
+    void playerReady();
 
 public slots:
     void playFile(const QFileInfo& file);
@@ -86,11 +116,20 @@ protected:
     void mouseDoubleClickEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 private:
+    void setupPlayer();
     void setupShortcuts();
     void processChaptersText(QString text);
     void copyFromClipboard();
     void checkForChapterFile(QString filePath);
+    void updateChapterThumbnails();
+    void updateIdle();
+    void onFirstFrame();
+    void addMatchingSubtitles(const QString& filePath);
+    void onPlayerMediaChanged();
+    void reopenCurrentMedia();
+    bool isVideoUnderMouse() const;
 
     int volumeAdjuster(int vol, int incrementOrDecrement);
 
@@ -100,6 +139,29 @@ private:
     VlcMediaPlayer *mPlayer;
     PlaylistPage *playlist;
     ChapterListPage *chapterListPage;
+    PlaybackStatsSampler *mStatsSampler;
+    DecodeQualityGovernor *mDecodeQualityGovernor;
+    SeekScheduler *mSeekScheduler;
+    KeyframeIndexer *mKeyframeIndexer;
+    ThumbnailProvider *mThumbnailProvider;
+    SnapshotPipeline *mSnapshotPipeline;
+    FramePool *mFramePool;
+    VideoSurface *mVideoSurface;   // only without the frame pool
+    bool mRenderThroughFramePool;
+    bool videoViewEvent;        // a watched video view passed the event on
+    BackgroundAudioMode *mBackgroundAudioMode;
+    FirstFrameTimer *mFirstFrameTimer;
+    bool fastStart;
+    QString deferredMediaPath;  // what fast start left for after the first frame
+    QFileInfo pendingFile;      // opened before libvlc was loaded
+    QStringList addedSubtitleFiles;
+    bool reopening;             // the governor opens the same file again
+    bool inputReopened;         // the current input is such a reopen
+    QMetaObject::Connection reopenedConnection;
+    bool idle;
+    bool videoVisible;
+    PerformanceProfile::Profile mPerformanceProfile;
+    PerformanceProfile::Profile mInstanceProfile;
     QClipboard* clipboard;
     QElapsedTimer clickElapsedTimer;
 
@@ -25,10 +25,8 @@
 #include <QMouseEvent>
 #include <QSlider>
 #include <QToolTip>
-#include <QRegularExpression>
 #include <QLabel>
 #include <QHBoxLayout>
-#include <QProxyStyle>
 #include <QStyleOptionSlider>
 #include <QToolButton>
 #include <QPainter>
@@ -37,6 +35,12 @@
 
 #include "../shared.h"
 #include "../settings.h"
+#include "../timeformat.h"
+#include "seekscheduler.h"
+#include "../keyframeindex.h"
+#include "thumbnailprovider.h"
+#include "thumbnailpopup.h"
+#include "playerstyle.h"
 
 int const MIN_SLIDER_VALUE = 0;
 int const MAX_SLIDER_VALUE = 10000;
@@ -66,9 +70,17 @@ class MediaProgressSlider : public QSlider
 public:
     explicit MediaProgressSlider(QWidget *parent = 0)
         : QSlider(parent),
-          vlcMediaPlayer(nullptr)
+          vlcMediaPlayer(nullptr),
+          seekScheduler(nullptr),
+          thumbnailProvider(nullptr),
+          thumbnailPopup(nullptr),
+          hoveredThumbnailSlot(-1),
+          length(0)
     {
         isLocked = false;
+        snapToKeyframes = Settings.snapToKeyframes();
+        dragSnapped = false;
+        dragTarget = 0;
         chaptersPresent = false;
         seeRemainingTimeLabel = Settings.seeRemainingTime();
 
@@ -91,8 +103,10 @@ public:
             {
                 seeRemainingTimeLabel = ! seeRemainingTimeLabel;
                 Settings.setSeeRemainingTime(seeRemainingTimeLabel);
+                remainingText.reset();
+                remainingText.setTime(mediaLength() - vlcMediaPlayer->time());
                 totalOrRemainingTimeLabel->setText( seeRemainingTimeLabel ?
-                                                    "-" + formattedTime((mediaLength() - vlcMediaPlayer->time())) :
+                                                    "-" + remainingText.text() :
                                                     formattedFullTime());
             }
         });
@@ -102,14 +116,17 @@ public:
         labelsLayout->addStretch();
         labelsLayout->addWidget(totalOrRemainingTimeLabel);
 
-        settingStyleSheet();
+        this->setStyle(PlayerStyle::instance(PlayerStyle::PROGRESS_SLIDER));
     }
 
     ~MediaProgressSlider() {}
 
     QHBoxLayout * timeLabelsLayout() const;
     void setMediaPlayer(VlcMediaPlayer *player);
-    void settingStyleSheet();
+    void setSeekScheduler(SeekScheduler *scheduler);
+    void setKeyframeIndex(const KeyframeIndex& index);
+    void setSnapToKeyframes(bool snap);
+    void setThumbnailProvider(ThumbnailProvider *provider);
     void unSetChapters();
     void setChapters(QStringList chapters, QList<qint64> timestamps);
     qint64 mediaLength();
@@ -142,15 +159,27 @@ private:
     bool isPlayerSeekable();
     int getValueFromXPos( int posX );
     int getValueFromMediaPlayerTime(qint64 time);
+    void seekTo(qint64 time);
 
     VlcMediaPlayer *vlcMediaPlayer;
+    SeekScheduler *seekScheduler;
+    KeyframeIndex keyframeIndex;
+    ThumbnailProvider *thumbnailProvider;
+    ThumbnailPopup *thumbnailPopup;
+    qint64 hoveredThumbnailSlot;
     qint64 length;
     QString fullTime;
+    TimeText elapsedText;
+    TimeText remainingText;
+    TimeText hoverText;
 
     bool isLocked;
     bool _lockIn;
     bool chaptersPresent;
     bool seeRemainingTimeLabel;
+    bool snapToKeyframes;
+    bool dragSnapped;
+    qint64 dragTarget;
 
     int currentChapterIndex;
     QLabel *timeElapsed;
@@ -165,6 +194,7 @@ private:
     void mouseMoveEvent(QMouseEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
     void wheelEvent(QWheelEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
 };
@@ -176,6 +206,9 @@ inline QHBoxLayout * MediaProgressSlider::timeLabelsLayout() const
 
 inline bool MediaProgressSlider::isPlayerSeekable()
 {
+    if(! vlcMediaPlayer)
+        return false;
+
     Vlc::State playerState = vlcMediaPlayer->state();
     return (playerState == Vlc::Playing || playerState == Vlc::Paused);
 }
@@ -201,64 +234,46 @@ inline void MediaProgressSlider::setMediaPlayer(VlcMediaPlayer *player)
     connect(vlcMediaPlayer, &VlcMediaPlayer::end, this, &MediaProgressSlider::onEndOfMedia);
     connect(vlcMediaPlayer, &VlcMediaPlayer::stopped, this, &MediaProgressSlider::onEndOfMedia);
     connect(vlcMediaPlayer, &VlcMediaPlayer::timeChanged, this, &MediaProgressSlider::updateCurrentTime);
-    connect(vlcMediaPlayer, &VlcMediaPlayer::mediaChanged, this, [this] {settingStyleSheet();});
-    connect(vlcMediaPlayer, &VlcMediaPlayer::mediaChanged, this, &MediaProgressSlider::unSetChapters);
     connect(vlcMediaPlayer, &VlcMediaPlayer::seekableChanged, this, &MediaProgressSlider::setEnabled);
     connect(vlcMediaPlayer, &VlcMediaPlayer::positionChanged, this, &MediaProgressSlider::updateCurrentPosition);
 }
 
-inline void MediaProgressSlider::settingStyleSheet()
-{
-    this->setStyleSheet( "QSlider::groove:horizontal {\n"
-                         "border: 1px solid #bbb;\n"
-                         "background: white;\n"
-                         "height: 10px;\n"
-                         "border-radius: 4px;\n"
-                         "margin-top: -2px;\n"
-                         "}\n"
-                         "QSlider::sub-page:horizontal {\n"
-                         "background-color: #53adcb;\n"
-                         "border: 1px solid #777;\n"
-                         "height: 10px;\n"
-                         "border-radius: 4px;\n"
-                         "margin-top: -2px;\n"
-                         "}\n"
-                         "QSlider::add-page:horizontal {\n"
-                         "background: #d7d6d5;\n"
-                         "border: 1px solid #777;\n"
-                         "height: 10px;\n"
-                         "border-radius: 4px;\n"
-                         "margin-top: -2px;\n"
-                         "}\n"
-                         "QSlider::handle:horizontal {\n"
-                         "background: qlineargradient(x1:0, y1:0, x2:1, y2:1,\n"
-                         "    stop:0 #eee, stop:1 #ccc);\n"
-                         "border: 1px solid #777;\n"
-                         "width: 13px;\n"
-                         "margin-top: -2px;\n"
-                         "margin-bottom: -2px;\n"
-                         "border-radius: 6px;\n"
-                         "}\n"
-                         "QSlider::handle:horizontal:hover {\n"
-                         "background: qlineargradient(x1:0, y1:0, x2:1, y2:1,\n"
-                         "    stop:0 #fff, stop:1 #ddd);\n"
-                         "border: 1px solid #444;\n"
-                         "border-radius: 6px;\n"
-                         "}\n"
-                         "QSlider::sub-page:horizontal:disabled {\n"
-                         "background: #bbb;\n"
-                         "border-color: #999;\n"
-                         "}\n"
-                         "QSlider::add-page:horizontal:disabled {\n"
-                         "background: #eee;\n"
-                         "border-color: #999;\n"
-                         "}\n"
-                         "QSlider::handle:horizontal:disabled {\n"
-                         "background: #eee;\n"
-                         "border: 1px solid #aaa;\n"
-                         "border-radius: 6px;\n"
-                         "}\n"
-                       );
+inline void MediaProgressSlider::setSeekScheduler(SeekScheduler *scheduler)
+{
+    seekScheduler = scheduler;
+}
+
+inline void MediaProgressSlider::setKeyframeIndex(const KeyframeIndex &index)
+{
+    keyframeIndex = index;
+}
+
+inline void MediaProgressSlider::setSnapToKeyframes(bool snap)
+{
+    snapToKeyframes = snap;
+}
+
+inline void MediaProgressSlider::setThumbnailProvider(ThumbnailProvider *provider)
+{
+    thumbnailProvider = provider;
+    hoveredThumbnailSlot = -1;
+
+    if(! thumbnailPopup)
+        thumbnailPopup = new ThumbnailPopup(this);
+
+    connect(thumbnailProvider, &ThumbnailProvider::thumbnailReady, this, [this] (qint64 slot, const QImage& image)
+    {
+        if(thumbnailPopup->isVisible() && slot == hoveredThumbnailSlot)
+            thumbnailPopup->setImage(image);
+    });
+}
+
+inline void MediaProgressSlider::seekTo(qint64 time)
+{
+    if(seekScheduler)
+        seekScheduler->seekTo(time);
+    else
+        vlcMediaPlayer->setTime(time);
 }
 
 inline float MediaProgressSlider::updateEvent(const QPoint &position)
@@ -282,7 +297,9 @@ inline void MediaProgressSlider::updateCurrentPosition(float position)
 
 inline void MediaProgressSlider::updateCurrentTime(qint64 time)
 {
-    timeElapsed->setText(formattedTime(time));
+    // timeChanged comes several times a second, the labels only change once a second
+    if(elapsedText.setTime(time))
+        timeElapsed->setText(elapsedText.text());
 
     if(chaptersPresent)
     {
@@ -298,9 +315,9 @@ inline void MediaProgressSlider::updateCurrentTime(qint64 time)
                 emit currentChapterUpdated(formattedTime(mediaChaptersTimestamps.at(currentChapterIndex)));
         }
     }
-    if(seeRemainingTimeLabel)
+    if(seeRemainingTimeLabel && remainingText.setTime(mediaLength() - time))
     {
-        totalOrRemainingTimeLabel->setText("-" + formattedTime(mediaLength() - time));
+        totalOrRemainingTimeLabel->setText("-" + remainingText.text());
     }
 }
 
@@ -312,14 +329,9 @@ inline void MediaProgressSlider::updateFullTime(qint64 time)
     }
     else
     {
+        length = time;
         fullTime = formattedTime(time);
-
-        QRegularExpression r("(?:(\\d+):)?(\\d+):(\\d+)");
-        QRegularExpressionMatch match = r.match(fullTime);
-        int hours   =  match.captured(1).isEmpty() ? 0 : match.captured(1).toInt();
-        int minutes =  match.captured(2).isEmpty() ? 0 : match.captured(2).toInt();
-        int seconds  = match.captured(3).isEmpty() ? 0 : match.captured(3).toInt();
-        length = ((hours * 3600000) + (minutes * 60000) + (seconds * 1000));
+        remainingText.reset();
 
         if(! seeRemainingTimeLabel)
             totalOrRemainingTimeLabel->setText(fullTime);
@@ -333,7 +345,7 @@ inline QString MediaProgressSlider::formattedFullTime()
 
 inline void MediaProgressSlider::updatePostionIfPlayerPaused()
 {
-    if(vlcMediaPlayer->isPaused())
+    if(vlcMediaPlayer && vlcMediaPlayer->isPaused())
     {
         updateCurrentPosition(vlcMediaPlayer->position());
     }
@@ -355,6 +367,10 @@ inline void MediaProgressSlider::onEndOfMedia()
     this->setValue(0);
     timeElapsed->setText("--:--");
     totalOrRemainingTimeLabel->setText("--:--");
+    elapsedText.reset();
+    remainingText.reset();
+    if(thumbnailPopup)
+        thumbnailPopup->hide();
     unSetChapters();
 }
 
@@ -365,7 +381,7 @@ inline void MediaProgressSlider::goToNextChapter()
         if(vlcMediaPlayer)
         {
             chapterLabel->setText(currentChapter(vlcMediaPlayer->time()));
-            vlcMediaPlayer->setTime(mediaChaptersTimestamps.at(currentChapterIndex + 1));
+            seekTo(mediaChaptersTimestamps.at(currentChapterIndex + 1));
 
             updatePostionIfPlayerPaused();
         }
@@ -379,7 +395,7 @@ inline void MediaProgressSlider::goToPreviousChapter()
     {
         if(vlcMediaPlayer)
         {
-            vlcMediaPlayer->setTime(mediaChaptersTimestamps.at(currentChapterIndex - 1));
+            seekTo(mediaChaptersTimestamps.at(currentChapterIndex - 1));
             chapterLabel->setText(currentChapter(vlcMediaPlayer->time()));
 
             updatePostionIfPlayerPaused();
@@ -499,20 +515,45 @@ inline void MediaProgressSlider::mouseMoveEvent(QMouseEvent *event)
     {
         if(isPlayerSeekable())
         {
-            QString hoverTime = formattedTime(newTime);
+            hoverText.setTime(newTime);
+            const QString& hoverTime = hoverText.text();
 
             QString chapter = chaptersPresent ?  currentChapter(newTime, false /*updateCurrentChapterIndex*/) : "";
-            QString toolTipText = chapter.isEmpty() ? hoverTime :
-                                  "<p style=\"text-align:center;\">" + chapter + "<br>" + hoverTime + "</p>";
 
-            QToolTip::showText(QCursor::pos(), toolTipText, nullptr);
+            if(thumbnailProvider)
+            {
+                // a null image means it is being grabbed, thumbnailReady brings it if the mouse is still there
+                hoveredThumbnailSlot = thumbnailProvider->slotOf(newTime);
+                thumbnailPopup->showPreview(mapToGlobal(QPoint(event->pos().x(), 0)),
+                                            thumbnailProvider->thumbnail(newTime),
+                                            chapter.isEmpty() ? hoverTime : chapter + "\n" + hoverTime);
+            }
+            else
+            {
+                QString toolTipText = chapter.isEmpty() ? hoverTime :
+                                      "<p style=\"text-align:center;\">" + chapter + "<br>" + hoverTime + "</p>";
+
+                QToolTip::showText(QCursor::pos(), toolTipText, nullptr);
+            }
         }
     }
 
-    if (!isLocked)
+    if (!isLocked || !vlcMediaPlayer)
         return;
 
-    vlcMediaPlayer->setTime(timeInRange(newTime));
+    // a drag produces a move event per pixel, the scheduler keeps only the latest one.
+    // Seeking to a keyframe needs no decoding up to the target, so scrubbing follows the
+    // mouse; the exact position is sought on release
+    dragTarget = timeInRange(newTime);
+    if(snapToKeyframes && ! keyframeIndex.isEmpty())
+    {
+        seekTo(keyframeIndex.keyframeAtOrBefore(dragTarget));
+        dragSnapped = true;
+    }
+    else
+    {
+        seekTo(dragTarget);
+    }
     if(vlcMediaPlayer->isPaused())
     {
         this->setValue(valueFromXPos);
@@ -522,6 +563,7 @@ inline void MediaProgressSlider::mouseMoveEvent(QMouseEvent *event)
 inline void MediaProgressSlider::mousePressEvent(QMouseEvent *event)
 {
     lock();
+    dragSnapped = false;
     if(isPlayerSeekable())
     {
         if(event->button()==Qt::LeftButton)
@@ -530,7 +572,7 @@ inline void MediaProgressSlider::mousePressEvent(QMouseEvent *event)
             qint64 newTime = (valueFromXPos * mediaLength()) / static_cast<float>(maximum());
 
             this->setValue(valueFromXPos);
-            vlcMediaPlayer->setTime(timeInRange(newTime));//WARNING: possible bug when pressing on near the end
+            seekTo(timeInRange(newTime));//WARNING: possible bug when pressing on near the end
         }
     }
 }
@@ -539,6 +581,21 @@ inline void MediaProgressSlider::mouseReleaseEvent(QMouseEvent *event)
 {
     event->ignore();
     unlock();
+
+    if(dragSnapped && isPlayerSeekable())
+    {
+        seekTo(dragTarget);
+        updatePostionIfPlayerPaused();
+    }
+    dragSnapped = false;
+}
+
+inline void MediaProgressSlider::leaveEvent(QEvent *event)
+{
+    if(thumbnailPopup)
+        thumbnailPopup->hide();
+
+    QSlider::leaveEvent(event);
 }
 
 inline void MediaProgressSlider::wheelEvent(QWheelEvent *event)
@@ -546,17 +603,12 @@ inline void MediaProgressSlider::wheelEvent(QWheelEvent *event)
     if (!vlcMediaPlayer)
         return;
 
-    if (event->angleDelta().y() > 0)
-    {
-        qint64 newTime =   vlcMediaPlayer->time() + 10000;
-
-        vlcMediaPlayer->setTime(timeInRange(newTime));
-    }
+    // notches add up against the pending target instead of the lagging player time
+    qint64 delta = (event->angleDelta().y() > 0) ? 10000 : -10000;
+    if(seekScheduler)
+        seekScheduler->seekBy(delta);
     else
-    {
-        int newTime = vlcMediaPlayer->time() - 10000;
-        vlcMediaPlayer->setTime(timeInRange(newTime));
-    }
+        vlcMediaPlayer->setTime(timeInRange(vlcMediaPlayer->time() + delta));
 
     updatePostionIfPlayerPaused();
 
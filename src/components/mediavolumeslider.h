@@ -25,22 +25,9 @@
 #include <QMouseEvent>
 #include <QMouseEvent>
 #include <QStyleOptionSlider>
-#include <QProxyStyle>
 
 #include "../settings.h"
-
-class MyStyle : public QProxyStyle
-{
-public:
-    using QProxyStyle::QProxyStyle;
-
-    int styleHint(QStyle::StyleHint hint, const QStyleOption* option = 0, const QWidget * widget = 0, QStyleHintReturn *retunData = 0 ) const
-    {
-        if(hint == QStyle::SH_Slider_AbsoluteSetButtons)
-            return (Qt::LeftButton | Qt::MiddleButton | Qt::RightButton);
-        return QProxyStyle::styleHint(hint, option, widget, retunData);
-    }
-};
+#include "playerstyle.h"
 
 class MediaVolumeSlider : public QSlider
 {
@@ -61,29 +48,7 @@ public:
             Settings.setVolume(volume);
         });
 
-        this->setStyle(new MyStyle(this->style()));
-
-        this->setStyleSheet( "QSlider::groove:horizontal {\n"
-                             "border: .5px solid #bbb;\n"
-                             "background: transparent;\n"
-                             "height: 2px;\n"
-                             "border-radius: 4px;\n"
-                             "margin-top: -2px;\n"
-                             "}\n"
-                             "QSlider::handle:horizontal {\n"
-                             "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, stop:0 #eee, stop:1 #ccc);\n"
-                             "border: 1px solid #777;\n"
-                             "width: 8px;\n"
-                             "margin-top: -2px;\n"
-                             "margin-bottom: -2px;\n"
-                             "border-radius: 6px;\n"
-                             "}\n"
-                             "\n"
-                             "QSlider::handle:horizontal:hover {\n"
-//                       "background: white;\n"
-                             "border: 1px solid #444;\n"
-                             "border-radius: 6px;\n"
-                             "}");
+        this->setStyle(PlayerStyle::instance(PlayerStyle::VOLUME_SLIDER));
     }
 
 signals:
@@ -34,6 +34,7 @@ PictureInPictureWindow::PictureInPictureWindow(QWidget *parent) :
     this->move((screenrect.right() - width() - 10), (screenrect.bottom() - height() - 70));
 
     timerMouse = new QTimer(this);
+    timerMouse->setSingleShot(true);
     connect(timerMouse, &QTimer::timeout, this, &PictureInPictureWindow::hideMouse);
 
     playerController = nullptr;
@@ -50,8 +51,11 @@ void PictureInPictureWindow::showMouse()
     if(playerController != nullptr)
     {
         this->setCursor(Qt::ArrowCursor);
-        playerController->setWindowFlags(Qt::WindowStaysOnTopHint);
-        playerController->show();
+        if(! playerController->isVisible() || ! playerController->isWindow())
+        {
+            playerController->setWindowFlags(Qt::WindowStaysOnTopHint);
+            playerController->show();
+        }
         timerMouse->start(1000);
     }
 }
@@ -0,0 +1,174 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "playbackstats.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "vlcqt/MediaPlayer.h"
+#include "../stallwatchdog.h"
+
+static int stallCount()
+{
+    return StallWatchdog::instance() ? StallWatchdog::instance()->stallCount() : 0;
+}
+
+// user and system time used by the process so far, in microseconds
+static qint64 processCpuTime()
+{
+#ifdef Q_OS_WIN
+    FILETIME creation, exit, kernel, user;
+    if(! GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+
+    auto toMicroseconds = [] (const FILETIME& time)
+    {
+        return ((qint64(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;
+    };
+    return toMicroseconds(kernel) + toMicroseconds(user);
+#else
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return qint64(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+            usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#endif
+}
+
+PlaybackStatsSampler::PlaybackStatsSampler(VlcMediaPlayer *player, QObject *parent)
+    : QObject(parent),
+      mPlayer(player),
+      hasPreviousStats(false),
+      previousCpuTime(0),
+      previousSampleTime(0),
+      previousStallCount(0)
+{
+    timer.setTimerType(Qt::CoarseTimer);
+    connect(&timer, &QTimer::timeout, this, &PlaybackStatsSampler::sample);
+
+    clock.start();
+}
+
+void PlaybackStatsSampler::setInterval(int msec)
+{
+    timer.setInterval(qMax(50, msec));
+}
+
+int PlaybackStatsSampler::interval() const
+{
+    return timer.interval();
+}
+
+bool PlaybackStatsSampler::isActive() const
+{
+    return timer.isActive();
+}
+
+const PlaybackStatsSampler::History &PlaybackStatsSampler::history() const
+{
+    return samples;
+}
+
+void PlaybackStatsSampler::start()
+{
+    if(! timer.isActive())
+        timer.start();
+}
+
+void PlaybackStatsSampler::stop()
+{
+    timer.stop();
+}
+
+void PlaybackStatsSampler::resetCounters()
+{
+    hasPreviousStats = false;
+}
+
+void PlaybackStatsSampler::sample()
+{
+    VlcMedia* media = mPlayer->currentMedia();
+
+    if(media == nullptr || ! media->getStats(&stats))
+        return;
+
+    // libvlc counters are cumulative and restart with every new input
+    qint64 cpuTime = processCpuTime();
+    qint64 sampleTime = clock.nsecsElapsed() / 1000;
+    int stalls = stallCount();
+
+    if(! hasPreviousStats || stats.decoded_video < previousStats.decoded_video)
+    {
+        previousStats = stats;
+        previousCpuTime = cpuTime;
+        previousSampleTime = sampleTime;
+        previousStallCount = stalls;
+        hasPreviousStats = true;
+        return;
+    }
+
+    PlaybackStatsSample sample;
+    sample.timestamp = clock.elapsed();
+    sample.inputBitrate = stats.input_bitrate * 8000;
+    sample.demuxBitrate = stats.demux_bitrate * 8000;
+    sample.decodedVideo = stats.decoded_video - previousStats.decoded_video;
+    sample.decodedAudio = stats.decoded_audio - previousStats.decoded_audio;
+    sample.displayedPictures = stats.displayed_pictures - previousStats.displayed_pictures;
+    sample.lostPictures = stats.lost_pictures - previousStats.lost_pictures;
+    sample.lostAudioBuffers = stats.lost_abuffers - previousStats.lost_abuffers;
+    sample.cpuUsage = (sampleTime > previousSampleTime) ?
+                100.0f * (cpuTime - previousCpuTime) / (sampleTime - previousSampleTime) : 0;
+    sample.guiStalls = stalls - previousStallCount;
+
+    previousStats = stats;
+    previousCpuTime = cpuTime;
+    previousSampleTime = sampleTime;
+    previousStallCount = stalls;
+    samples.push(sample);
+
+    emit sampled(sample);
+}
+
+bool PlaybackStatsSampler::exportToCsv(const QString &filePath) const
+{
+    QFile file(filePath);
+
+    if(! file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    out << "time_ms,input_bitrate_kbps,demux_bitrate_kbps,decoded_video,displayed_pictures,lost_pictures,lost_abuffers,cpu_percent,gui_stalls\n";
+
+    for(std::size_t i = 0; i < samples.size(); ++i)
+    {
+        const PlaybackStatsSample& s = samples.at(i);
+        out << s.timestamp << ',' << s.inputBitrate << ',' << s.demuxBitrate << ','
+            << s.decodedVideo << ',' << s.displayedPictures << ','
+            << s.lostPictures << ',' << s.lostAudioBuffers << ',' << s.cpuUsage << ',' << s.guiStalls << '\n';
+    }
+
+    return true;
+}
@@ -0,0 +1,84 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef PLAYBACKSTATS_H
+#define PLAYBACKSTATS_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "vlcqt/Stats.h"
+#include "../ringbuffer.h"
+
+class VlcMediaPlayer;
+
+struct PlaybackStatsSample
+{
+    qint64 timestamp;       // ms since the sampler was created
+    float inputBitrate;     // kb/s
+    float demuxBitrate;     // kb/s
+    int decodedVideo;       // the counters are deltas since the previous sample
+    int decodedAudio;
+    int displayedPictures;
+    int lostPictures;
+    int lostAudioBuffers;
+    float cpuUsage;         // % of one core used by the whole process
+    int guiStalls;          // GUI thread stalls over the watchdog threshold
+};
+
+class PlaybackStatsSampler : public QObject
+{
+    Q_OBJECT
+public:
+    enum { HISTORY_SIZE = 240 };
+    typedef RingBuffer<PlaybackStatsSample, HISTORY_SIZE> History;
+
+    explicit PlaybackStatsSampler(VlcMediaPlayer* player, QObject *parent = nullptr);
+
+    void setInterval(int msec);
+    int interval() const;
+    bool isActive() const;
+    const History& history() const;
+    bool exportToCsv(const QString& filePath) const;
+
+signals:
+    void sampled(const PlaybackStatsSample& sample);
+
+public slots:
+    void start();
+    void stop();
+    void resetCounters();
+
+private slots:
+    void sample();
+
+private:
+    VlcMediaPlayer* mPlayer;
+    QTimer timer;
+    QElapsedTimer clock;
+    History samples;
+    VlcStats stats;
+    VlcStats previousStats;
+    bool hasPreviousStats;
+    qint64 previousCpuTime;
+    qint64 previousSampleTime;
+    int previousStallCount;
+};
+
+#endif // PLAYBACKSTATS_H
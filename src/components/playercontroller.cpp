@@ -27,6 +27,8 @@
 #include <QWinThumbnailToolButton>
 #include <QWinThumbnailToolBar>
 #endif
+#include "playerstyle.h"
+#include "../iconatlas.h"
 #include "../shared.h"
 #include "../settings.h"
 
@@ -44,7 +46,6 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
     mediaState = Vlc::Idle;
 
     this->setMouseTracking(true);
-    this->setStyleSheet("QToolButton{background-color: #dddddd;}");
 
     mediaProgress = new MediaProgressSlider(this);
 
@@ -55,6 +56,7 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
     playButton = new QToolButton;
     setPlayButtonIcon(true);
     playButton->setCursor(Qt::PointingHandCursor);
+    playButton->setStyle(PlayerStyle::instance());
     playButton->setSizePolicy(QSizePolicy::Fixed,QSizePolicy::Fixed);
     playButton->setToolTip(tr("Play\nIf the playlist is empty, open a medium"));
     playButton->setMaximumSize(QSize(36,36));
@@ -62,19 +64,19 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
     QHBoxLayout *playBackLayout = new QHBoxLayout;
 
     previousButton = new QToolButton;
-    setUpCommonToolButton(previousButton, style()->standardIcon(QStyle::SP_MediaSkipBackward), tr("Previous media in the playlist"));
+    setUpCommonToolButton(previousButton, IconAtlas::icon(IconAtlas::PREVIOUS), tr("Previous media in the playlist"));
 
     seekBackwardButton = new QToolButton;
-    setUpCommonToolButton(seekBackwardButton,style()->standardIcon(QStyle::SP_MediaSeekBackward), tr("Seek backward 10 seconds"), true);
+    setUpCommonToolButton(seekBackwardButton,IconAtlas::icon(IconAtlas::SEEK_BACKWARD), tr("Seek backward 10 seconds"), true);
 
     stopButton = new QToolButton;    
-    setUpCommonToolButton(stopButton, style()->standardIcon(QStyle::SP_MediaStop), tr("Stop playback"));
+    setUpCommonToolButton(stopButton, IconAtlas::icon(IconAtlas::STOP), tr("Stop playback"));
 
     seekForwardButton = new QToolButton;
-    setUpCommonToolButton(seekForwardButton, style()->standardIcon(QStyle::SP_MediaSeekForward), tr("eek forward 10 seconds"), true);
+    setUpCommonToolButton(seekForwardButton, IconAtlas::icon(IconAtlas::SEEK_FORWARD), tr("eek forward 10 seconds"), true);
 
     nextButton = new QToolButton;
-    setUpCommonToolButton(nextButton, style()->standardIcon(QStyle::SP_MediaSkipForward), tr("Next media in the playlist"));
+    setUpCommonToolButton(nextButton, IconAtlas::icon(IconAtlas::NEXT), tr("Next media in the playlist"));
 
     playBackLayout->addWidget(previousButton);
     playBackLayout->addWidget(seekBackwardButton);
@@ -84,11 +86,11 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
     playBackLayout->setSpacing(1);
 
     fullScreenButton = new QToolButton;
-    setUpCommonToolButton(fullScreenButton, QIcon(":/images/icons/fullscreen.png"), tr("Toggle the video in full screen"));
+    setUpCommonToolButton(fullScreenButton, IconAtlas::icon(IconAtlas::FULLSCREEN), tr("Toggle the video in full screen"));
     fullScreenButton->setEnabled(false);
 
     picInPicButton = new QToolButton;
-    setUpCommonToolButton(picInPicButton, QIcon(":/images/icons/picture-in-picture.png"), tr("Toggle the video in picture in picture"));
+    setUpCommonToolButton(picInPicButton, IconAtlas::icon(IconAtlas::PIC_IN_PIC), tr("Toggle the video in picture in picture"));
 
     extendedSettingsButton = new QToolButton;
     setUpCommonToolButton(extendedSettingsButton, QIcon(":/images/icons/extendedSettings.png"), tr("how extended settings"));
@@ -101,15 +103,15 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
     settingsLayout->setSpacing(0);
 
     playlistButton = new QToolButton;
-    setUpCommonToolButton(playlistButton, QIcon(":/images/icons/playlist.png"), tr("Show/hide playlist"));
+    setUpCommonToolButton(playlistButton, IconAtlas::icon(IconAtlas::PLAYLIST), tr("Show/hide playlist"));
 
     loopButton = new QToolButton;
-    setUpCommonToolButton(loopButton, QIcon(":/images/icons/toggleRepeat.png"), tr("Click to toggle between loop all, loop one and no loop"));
+    setUpCommonToolButton(loopButton, IconAtlas::icon(IconAtlas::TOGGLE_REPEAT), tr("Click to toggle between loop all, loop one and no loop"));
     loopButton->setCheckable(true);
     setupLoopButton(loop);
 
     randomButton = new QToolButton;
-    setUpCommonToolButton(randomButton, QIcon(":/images/icons/random.png"), tr("Random"));
+    setUpCommonToolButton(randomButton, IconAtlas::icon(IconAtlas::RANDOM), tr("Random"));
     randomButton->setCheckable(true);
     randomButton->setChecked(random);
 
@@ -119,15 +121,15 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
     playListLayout->setSpacing(0);
 
     chapterListButton = new QToolButton;
-    setUpCommonToolButton(chapterListButton, QIcon(":/images/icons/chapterList.png"), tr("how/hide chapter list"));
+    setUpCommonToolButton(chapterListButton, IconAtlas::icon(IconAtlas::CHAPTER_LIST), tr("how/hide chapter list"));
 
     QToolButton* nextChapterButton = new QToolButton;
-    setUpCommonToolButton(nextChapterButton, QIcon(":/images/icons/nextChapter.png"), tr("ext Chapte"));
+    setUpCommonToolButton(nextChapterButton, IconAtlas::icon(IconAtlas::NEXT_CHAPTER), tr("ext Chapte"));
     nextChapterButton->hide();
     connect(nextChapterButton, &QToolButton::clicked, mediaProgress, &MediaProgressSlider::goToNextChapter);
 
     QToolButton* previousChapterButton = new QToolButton;
-    setUpCommonToolButton(previousChapterButton, QIcon(":/images/icons/previousChapter.png"), tr("revious Chapter"));
+    setUpCommonToolButton(previousChapterButton, IconAtlas::icon(IconAtlas::PREVIOUS_CHAPTER), tr("revious Chapter"));
     previousChapterButton->hide();
     connect(previousChapterButton, &QToolButton::clicked, mediaProgress, &MediaProgressSlider::goToPreviousChapter);
 
@@ -138,8 +140,9 @@ PlayerController::PlayerController(QWidget *parent) : QWidget(parent)
 
     volButton = new QToolButton;
     volButton->setCursor(Qt::PointingHandCursor);
-    volButton->setIcon(style()->standardIcon(QStyle::SP_MediaVolume));
-    volButton->setStyleSheet("border:none;background:transparent;");
+    volButton->setIcon(IconAtlas::icon(IconAtlas::VOLUME));
+    volButton->setStyle(PlayerStyle::instance());
+    volButton->setAutoRaise(true);
     volButton->setCheckable(true);
     volButton->setChecked(muted);
     toggleVolButton(muted);
@@ -228,12 +231,12 @@ void PlayerController::toggleVolButton(bool isLoud)
 
     if(isLoud)
     {
-        volButton->setIcon(style()->standardIcon(QStyle::SP_MediaVolumeMuted));
+        volButton->setIcon(IconAtlas::icon(IconAtlas::VOLUME_MUTED));
         emit muteVolume(true);
     }
     else
     {
-        volButton->setIcon(style()->standardIcon(QStyle::SP_MediaVolume));
+        volButton->setIcon(IconAtlas::icon(IconAtlas::VOLUME));
         emit muteVolume(false);
     }
 }
@@ -296,7 +299,7 @@ void PlayerController::setPicInPicView(bool picInPicView)
     chapterListButton->setVisible(! picInPicView);
     volButton->setVisible(! picInPicView);
     mediaVolumeSlider->setVisible(! picInPicView);
-    picInPicButton->setIcon(picInPicView ? QIcon(":/images/icons/exit-picture-in-picture.png") :  QIcon(":/images/icons/picture-in-picture.png"));
+    picInPicButton->setIcon(picInPicView ? IconAtlas::icon(IconAtlas::EXIT_PIC_IN_PIC) :  IconAtlas::icon(IconAtlas::PIC_IN_PIC));
 
     this->setMinimumSize(QSize( picInPicView ? 0 : 480,  picInPicView ? 0: 72));
 }
@@ -327,19 +330,19 @@ void PlayerController::setupLoopButton(int mode)
     if(mode == NO_LOOP)
     {
         loopButton->setProperty("state",QVariant(NO_LOOP));
-        loopButton->setIcon(QIcon(":/images/icons/toggleRepeat.png"));
+        loopButton->setIcon(IconAtlas::icon(IconAtlas::TOGGLE_REPEAT));
         loopButton->setChecked(false);
     }
     else if(mode == LOOP_ALL)
     {
         loopButton->setProperty("state",QVariant(LOOP_ALL));
-        loopButton->setIcon(QIcon(":/images/icons/toggleRepeat.png"));
+        loopButton->setIcon(IconAtlas::icon(IconAtlas::TOGGLE_REPEAT));
         loopButton->setChecked(true);
     }
     else if(mode == LOOP_CURRENT)
     {
         loopButton->setProperty("state",QVariant(LOOP_CURRENT));
-        loopButton->setIcon(QIcon(":/images/icons/loop_current.png"));
+        loopButton->setIcon(IconAtlas::icon(IconAtlas::LOOP_CURRENT));
         loopButton->setChecked(true);
     }
 }
@@ -363,7 +366,7 @@ void PlayerController::onPlaylistMediaNumberChanged(int number)
 
 void PlayerController::setFullScreenButtonIcon(bool isInFullscreen)
 {
-    fullScreenButton->setIcon( isInFullscreen ? QIcon(":/images/icons/exit-fullscreen.png") : QIcon(":/images/icons/fullscreen.png"));
+    fullScreenButton->setIcon( isInFullscreen ? IconAtlas::icon(IconAtlas::EXIT_FULLSCREEN) : IconAtlas::icon(IconAtlas::FULLSCREEN));
 }
 
 void PlayerController::syncToVideoTime()
@@ -381,11 +384,11 @@ void PlayerController::createWinThumbnailToolBar(QWidget* widget)
     connect(playThumbnailButton, &QWinThumbnailToolButton::clicked, this, &PlayerController::onPlayClicked);
 
     previousThumbnailButton = new QWinThumbnailToolButton(thumbnailToolBar);
-    previousThumbnailButton->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaSkipBackward)));
+    previousThumbnailButton->setIcon(IconAtlas::icon(IconAtlas::PREVIOUS, IconAtlas::INVERTED));
     connect(previousThumbnailButton, &QWinThumbnailToolButton::clicked, this, &PlayerController::previous);
 
     nextThumbnailButton = new QWinThumbnailToolButton(thumbnailToolBar);
-    nextThumbnailButton->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaSkipForward)));
+    nextThumbnailButton->setIcon(IconAtlas::icon(IconAtlas::NEXT, IconAtlas::INVERTED));
     connect(nextThumbnailButton, &QWinThumbnailToolButton::clicked, this, &PlayerController::next);
 
     thumbnailToolBar->addButton(previousThumbnailButton);
@@ -401,18 +404,18 @@ void PlayerController::setPlayButtonIcon(bool playButtonIcon)
 {
     if(playButtonIcon)
     {
-        playButton->setIcon(style()->standardIcon(QStyle::SP_MediaPlay));
+        playButton->setIcon(IconAtlas::icon(IconAtlas::PLAY));
         playButton->setToolTip(tr("Play"));
 #ifdef Q_OS_WIN
-            playThumbnailButton->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaPlay)));
+            playThumbnailButton->setIcon(IconAtlas::icon(IconAtlas::PLAY, IconAtlas::INVERTED));
 #endif
     }
     else
     {
-        playButton->setIcon(style()->standardIcon(QStyle::SP_MediaPause));
+        playButton->setIcon(IconAtlas::icon(IconAtlas::PAUSE));
         playButton->setToolTip(tr("Pause the playback"));
 #ifdef Q_OS_WIN
-            playThumbnailButton->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaPause)));
+            playThumbnailButton->setIcon(IconAtlas::icon(IconAtlas::PAUSE, IconAtlas::INVERTED));
 #endif
     }
 }
@@ -420,6 +423,7 @@ void PlayerController::setPlayButtonIcon(bool playButtonIcon)
 void PlayerController::setUpCommonToolButton(QToolButton *button, const QIcon &icon, const QString &tooltip, bool autoRepeat)
 {
     button->setCursor(Qt::PointingHandCursor);
+    button->setStyle(PlayerStyle::instance());
     button->setIcon(icon);
     button->setSizePolicy(QSizePolicy::Fixed,QSizePolicy::Fixed);
     button->setMaximumSize(QSize(28,28));
@@ -20,7 +20,6 @@
 #define PLAYERCONTROLLER_H
 
 #include <QWidget>
-#include <QMediaPlayer>
 #include <QBoxLayout>
 
 #include "mediaprogressslider.h"
@@ -0,0 +1,183 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "playerstyle.h"
+
+#include <QApplication>
+#include <QPainter>
+#include <QPointer>
+#include <QStyleOptionSlider>
+#include <QSlider>
+#include <QToolButton>
+
+const int PROGRESS_GROOVE_HEIGHT = 10;
+const int PROGRESS_HANDLE_WIDTH = 13;
+const int VOLUME_GROOVE_HEIGHT = 2;
+const int VOLUME_HANDLE_WIDTH = 8;
+const int HANDLE_OVERHANG = 2;
+const int SLIDER_THICKNESS = 16;
+const QColor TOOL_BUTTON_COLOR(0xdd, 0xdd, 0xdd);
+
+PlayerStyle::PlayerStyle(SliderLook look)
+    : QProxyStyle(),
+      look(look)
+{
+}
+
+PlayerStyle *PlayerStyle::instance(SliderLook look)
+{
+    static QPointer<PlayerStyle> instances[2];
+
+    if(! instances[look])
+    {
+        instances[look] = new PlayerStyle(look);
+        instances[look]->setParent(qApp);
+    }
+
+    return instances[look];
+}
+
+// hover states are only delivered to widgets that ask for them
+void PlayerStyle::polish(QWidget *widget)
+{
+    if(qobject_cast<QSlider*>(widget) || qobject_cast<QToolButton*>(widget))
+        widget->setAttribute(Qt::WA_Hover);
+
+    QProxyStyle::polish(widget);
+}
+
+void PlayerStyle::unpolish(QWidget *widget)
+{
+    if(qobject_cast<QSlider*>(widget) || qobject_cast<QToolButton*>(widget))
+        widget->setAttribute(Qt::WA_Hover, false);
+
+    QProxyStyle::unpolish(widget);
+}
+
+void PlayerStyle::drawComplexControl(ComplexControl control, const QStyleOptionComplex *option, QPainter *painter, const QWidget *widget) const
+{
+    const QStyleOptionSlider* slider = qstyleoption_cast<const QStyleOptionSlider*>(option);
+    if(control == CC_Slider && slider && slider->orientation == Qt::Horizontal)
+    {
+        drawSlider(slider, painter, widget);
+        return;
+    }
+
+    QProxyStyle::drawComplexControl(control, option, painter, widget);
+}
+
+// flat panel, auto raise buttons have none at all
+void PlayerStyle::drawPrimitive(PrimitiveElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget) const
+{
+    if(element == PE_PanelButtonTool)
+    {
+        if(option->state & State_AutoRaise)
+            return;
+
+        QColor color = TOOL_BUTTON_COLOR;
+        if(option->state & (State_Sunken | State_On))
+            color = color.darker(118);
+        else if(option->state & State_MouseOver && option->state & State_Enabled)
+            color = color.lighter(106);
+
+        painter->fillRect(option->rect, color);
+        return;
+    }
+
+    QProxyStyle::drawPrimitive(element, option, painter, widget);
+}
+
+int PlayerStyle::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWidget *widget) const
+{
+    if(metric == PM_SliderLength)
+        return look == PROGRESS_SLIDER ? PROGRESS_HANDLE_WIDTH : VOLUME_HANDLE_WIDTH;
+    if(metric == PM_SliderThickness)
+        return SLIDER_THICKNESS;
+
+    return QProxyStyle::pixelMetric(metric, option, widget);
+}
+
+int PlayerStyle::styleHint(StyleHint hint, const QStyleOption *option, const QWidget *widget, QStyleHintReturn *returnData) const
+{
+    // the volume jumps to wherever it is clicked
+    if(hint == SH_Slider_AbsoluteSetButtons && look == VOLUME_SLIDER)
+        return Qt::LeftButton | Qt::MiddleButton | Qt::RightButton;
+
+    return QProxyStyle::styleHint(hint, option, widget, returnData);
+}
+
+void PlayerStyle::drawSlider(const QStyleOptionSlider *option, QPainter *painter, const QWidget *widget) const
+{
+    bool enabled = option->state & State_Enabled;
+    bool handleHovered = enabled && option->state & State_MouseOver && option->activeSubControls & SC_SliderHandle;
+    int grooveHeight = look == PROGRESS_SLIDER ? PROGRESS_GROOVE_HEIGHT : VOLUME_GROOVE_HEIGHT;
+
+    QRect handle = proxy()->subControlRect(CC_Slider, option, SC_SliderHandle, widget);
+    QRectF groove(option->rect.left() + 0.5, option->rect.center().y() - grooveHeight / 2 + 0.5,
+                  option->rect.width() - 1, grooveHeight - 1);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    if(look == PROGRESS_SLIDER)
+    {
+        QPen border(enabled ? QColor(0x77, 0x77, 0x77) : QColor(0x99, 0x99, 0x99));
+        painter->setPen(border);
+        painter->setBrush(enabled ? QColor(0xd7, 0xd6, 0xd5) : QColor(0xee, 0xee, 0xee));
+        painter->drawRoundedRect(groove, 4, 4);
+
+        QRectF played = groove;
+        played.setRight(handle.center().x());
+        if(played.width() > 0)
+        {
+            painter->setBrush(enabled ? QColor(0x53, 0xad, 0xcb) : QColor(0xbb, 0xbb, 0xbb));
+            painter->drawRoundedRect(played, 4, 4);
+        }
+    }
+    else
+    {
+        painter->setPen(QColor(0xbb, 0xbb, 0xbb));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRoundedRect(groove, 1, 1);
+    }
+
+    QRectF knob(handle.left() + 0.5, groove.top() - HANDLE_OVERHANG, handle.width() - 1, groove.height() + 2 * HANDLE_OVERHANG);
+    QLinearGradient gradient(knob.topLeft(), knob.bottomRight());
+    if(! enabled)
+    {
+        gradient.setColorAt(0, QColor(0xee, 0xee, 0xee));
+        gradient.setColorAt(1, QColor(0xee, 0xee, 0xee));
+        painter->setPen(QColor(0xaa, 0xaa, 0xaa));
+    }
+    else if(handleHovered)
+    {
+        gradient.setColorAt(0, Qt::white);
+        gradient.setColorAt(1, QColor(0xdd, 0xdd, 0xdd));
+        painter->setPen(QColor(0x44, 0x44, 0x44));
+    }
+    else
+    {
+        gradient.setColorAt(0, QColor(0xee, 0xee, 0xee));
+        gradient.setColorAt(1, QColor(0xcc, 0xcc, 0xcc));
+        painter->setPen(QColor(0x77, 0x77, 0x77));
+    }
+    painter->setBrush(gradient);
+    painter->drawRoundedRect(knob, 6, 6);
+
+    painter->restore();
+}
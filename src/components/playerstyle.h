@@ -0,0 +1,55 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef PLAYERSTYLE_H
+#define PLAYERSTYLE_H
+
+#include <QProxyStyle>
+
+// Paints the sliders and tool buttons of the player controls directly, in
+// place of style sheets, which Qt re-parses and re-polishes whenever they are
+// set. Set on each widget, child widgets do not inherit it. The shared
+// instances belong to the application and outlive every widget.
+class PlayerStyle : public QProxyStyle
+{
+    Q_OBJECT
+public:
+    enum SliderLook
+    {
+        PROGRESS_SLIDER,
+        VOLUME_SLIDER
+    };
+
+    explicit PlayerStyle(SliderLook look = PROGRESS_SLIDER);
+
+    static PlayerStyle* instance(SliderLook look = PROGRESS_SLIDER);
+
+    void polish(QWidget *widget) override;
+    void unpolish(QWidget *widget) override;
+    void drawComplexControl(ComplexControl control, const QStyleOptionComplex *option, QPainter *painter, const QWidget *widget = nullptr) const override;
+    void drawPrimitive(PrimitiveElement element, const QStyleOption *option, QPainter *painter, const QWidget *widget = nullptr) const override;
+    int pixelMetric(PixelMetric metric, const QStyleOption *option = nullptr, const QWidget *widget = nullptr) const override;
+    int styleHint(StyleHint hint, const QStyleOption *option = nullptr, const QWidget *widget = nullptr, QStyleHintReturn *returnData = nullptr) const override;
+
+private:
+    void drawSlider(const QStyleOptionSlider *option, QPainter *painter, const QWidget *widget) const;
+
+    SliderLook look;
+};
+
+#endif // PLAYERSTYLE_H
@@ -31,6 +31,8 @@
 #include <algorithm>
 
 #include "../shared.h"
+#include "../stallwatchdog.h"
+#include "../tracer.h"
 
 PlaylistPage::PlaylistPage()
 {
@@ -69,6 +71,9 @@ PlaylistPage::PlaylistPage()
 
 void PlaylistPage::addFiles(QList<QFileInfo> files, bool play)
 {
+    STALL_MARKER("PlaylistPage::addFiles");
+    TRACE_SCOPE("PlaylistPage::addFiles");
+
     if(files.isEmpty())
         return;
 
@@ -176,6 +181,7 @@ void PlaylistPage::playPrevious()
 
 void PlaylistPage::playCurrent()
 {
+    STALL_MARKER("PlaylistPage::playCurrent");
     emit playSelected(fileAt(currentFilePosition));
     emit mediaChanged(playlistFiles.at(currentFilePosition).fileName());
 
@@ -196,6 +202,7 @@ bool PlaylistPage::isAtEnd()
 
 void PlaylistPage::clearPlaylist()
 {
+    TRACE_SCOPE("PlaylistPage::clearPlaylist");
     this->clear();
     playlistFiles.clear();
     currentPlayingList.clear();
@@ -204,6 +211,7 @@ void PlaylistPage::clearPlaylist()
 
 void PlaylistPage::setRandom(bool random)
 {
+    TRACE_SCOPE("PlaylistPage::setRandom");
     isRandom = random;
 
     if(! currentPlayingList.isEmpty())
@@ -252,6 +260,7 @@ bool PlaylistPage::isEmpty()
 
 void PlaylistPage::onRowsMoved(const QModelIndex &, int start, int end, const QModelIndex &, int row)
 {
+    TRACE_SCOPE("PlaylistPage::onRowsMoved");
     if((start >= 0 && start < playlistFiles.size()) && (row >= 0 && row < playlistFiles.size()))
     {
         if(start < row)
@@ -270,6 +279,8 @@ void PlaylistPage::onRowsMoved(const QModelIndex &, int start, int end, const QM
 
 void PlaylistPage::removeSelected()
 {
+    STALL_MARKER("PlaylistPage::removeSelected");
+    TRACE_SCOPE("PlaylistPage::removeSelected");
     auto indexes = this->selectedIndexes();
 
     std::sort(indexes.begin(), indexes.end(), [] (QModelIndex ind, QModelIndex ind2)->bool
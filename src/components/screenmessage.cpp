@@ -43,7 +43,8 @@ ScreenMessage::ScreenMessage()
     layout.addWidget(&label, 0, 0);
     setLayout(&layout);
 
-    timer = new QTimer();
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
     connect(timer, &QTimer::timeout, this, &ScreenMessage::hide);
 }
 
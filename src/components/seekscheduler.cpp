@@ -0,0 +1,127 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "seekscheduler.h"
+
+#include "vlcqt/MediaPlayer.h"
+#include "../stallwatchdog.h"
+#include "../tracer.h"
+
+// a seek counts as landed when libvlc reports a time this close to the target,
+// or after the timeout when it reports nothing useful (e.g. seeking past the end)
+const qint64 LANDING_TOLERANCE = 1000;
+const int LANDING_TIMEOUT = 250;
+
+SeekScheduler::SeekScheduler(VlcMediaPlayer *player, QObject *parent)
+    : QObject(parent),
+      mPlayer(player),
+      length(0),
+      pendingTarget(-1),
+      inFlightTarget(-1)
+{
+    landingTimeout.setSingleShot(true);
+    landingTimeout.setInterval(LANDING_TIMEOUT);
+    connect(&landingTimeout, &QTimer::timeout, this, &SeekScheduler::land);
+
+    connect(mPlayer, &VlcMediaPlayer::timeChanged, this, &SeekScheduler::onTimeChanged);
+    connect(mPlayer, &VlcMediaPlayer::lengthChanged, this, [this] (int newLength) { length = newLength; });
+    connect(mPlayer, &VlcMediaPlayer::mediaChanged, this, &SeekScheduler::cancel);
+    connect(mPlayer, &VlcMediaPlayer::stopped, this, &SeekScheduler::cancel);
+    connect(mPlayer, &VlcMediaPlayer::end, this, &SeekScheduler::cancel);
+}
+
+void SeekScheduler::seekTo(qint64 time)
+{
+    pendingTarget = clamped(time);
+
+    if(inFlightTarget < 0)
+        issue();
+}
+
+void SeekScheduler::seekBy(qint64 delta)
+{
+    seekTo(targetTime() + delta);
+}
+
+qint64 SeekScheduler::targetTime() const
+{
+    if(pendingTarget >= 0)
+        return pendingTarget;
+    if(inFlightTarget >= 0)
+        return inFlightTarget;
+
+    return mPlayer->time();
+}
+
+bool SeekScheduler::isSeeking() const
+{
+    return pendingTarget >= 0 || inFlightTarget >= 0;
+}
+
+void SeekScheduler::cancel()
+{
+    if(inFlightTarget >= 0)
+        Tracer::asyncEnd("seek", quint64(inFlightTarget));
+
+    landingTimeout.stop();
+    pendingTarget = -1;
+    inFlightTarget = -1;
+}
+
+void SeekScheduler::issue()
+{
+    qint64 target = pendingTarget;
+    inFlightTarget = target;
+    pendingTarget = -1;
+    landingTimeout.start();
+
+    // when paused setTime reports the new time right away, which may land the seek before it returns
+    emit seekIssued(target);
+    Tracer::asyncBegin("seek", quint64(target));
+
+    STALL_MARKER("VlcMediaPlayer::setTime");
+    TRACE_SCOPE("VlcMediaPlayer::setTime");
+    mPlayer->setTime(target);
+}
+
+void SeekScheduler::land()
+{
+    Tracer::asyncEnd("seek", quint64(inFlightTarget));
+    landingTimeout.stop();
+    inFlightTarget = -1;
+
+    // only the latest target matters, everything requested in between was replaced
+    if(pendingTarget >= 0)
+        issue();
+}
+
+void SeekScheduler::onTimeChanged(int time)
+{
+    if(inFlightTarget >= 0 && qAbs(time - inFlightTarget) <= LANDING_TOLERANCE)
+        land();
+}
+
+qint64 SeekScheduler::clamped(qint64 time) const
+{
+    if(time < 0)
+        return 0;
+    if(length > 0 && time > length)
+        return length;
+
+    return time;
+}
@@ -0,0 +1,61 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef SEEKSCHEDULER_H
+#define SEEKSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+
+class VlcMediaPlayer;
+
+// Every seek goes through here. Only one libvlc seek is in flight at a time,
+// newer requests replace the pending target and are issued once the previous
+// seek has landed. Relative seeks add up against the pending target, so five
+// quick presses of "10 s forward" really move 50 s.
+class SeekScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SeekScheduler(VlcMediaPlayer* player, QObject *parent = nullptr);
+
+    void seekTo(qint64 time);
+    void seekBy(qint64 delta);
+    qint64 targetTime() const;
+    bool isSeeking() const;
+
+signals:
+    void seekIssued(qint64 time);
+
+public slots:
+    void cancel();
+
+private:
+    void issue();
+    void land();
+    void onTimeChanged(int time);
+    qint64 clamped(qint64 time) const;
+
+    VlcMediaPlayer* mPlayer;
+    QTimer landingTimeout;
+    qint64 length;
+    qint64 pendingTarget;
+    qint64 inFlightTarget;
+};
+
+#endif // SEEKSCHEDULER_H
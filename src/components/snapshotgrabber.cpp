@@ -0,0 +1,194 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "snapshotgrabber.h"
+
+#include <QDir>
+#include <QDebug>
+#include <cstring>
+#include <limits>
+
+// time allowed to open the file and reach the start, on top of the burst itself
+const int CAPTURE_TIMEOUT = 5000;
+// a frame this close to the wanted time is the one shown at that time
+const qint64 FRAME_TOLERANCE = 20;
+const qint64 NO_FRAME_WANTED = std::numeric_limits<qint64>::max();
+
+SnapshotGrabber::SnapshotGrabber(libvlc_instance_t *instance, QObject *parent)
+    : QObject(parent),
+      instance(instance),
+      player(nullptr),
+      session(0),
+      captured(0),
+      captureTimeout(this),
+      nextTime(NO_FRAME_WANTED)
+{
+    current.request = -1;
+    captureTimeout.setSingleShot(true);
+    connect(&captureTimeout, &QTimer::timeout, this, [this]
+    {
+        qWarning() << "Snapshot: gave up on" << current.filePath << "after" << captured << "of" << current.count << "frames";
+        finish();
+    });
+}
+
+SnapshotGrabber::~SnapshotGrabber()
+{
+    stop();
+}
+
+void SnapshotGrabber::capture(int request, const QString &filePath, qint64 time, int count, int interval)
+{
+    queue.enqueue({request, filePath, time, qMax(1, count), qMax(0, interval)});
+
+    if(! player)
+        startNext();
+}
+
+void SnapshotGrabber::stop()
+{
+    queue.clear();
+    if(player)
+        finish();
+}
+
+void SnapshotGrabber::startNext()
+{
+    while(! queue.isEmpty() && ! player)
+    {
+        current = queue.dequeue();
+        captured = 0;
+        ++session;
+
+        libvlc_media_t* media = libvlc_media_new_path(instance, QDir::toNativeSeparators(current.filePath).toUtf8().constData());
+        if(! media)
+        {
+            emit captureFinished(current.request, 0);
+            continue;
+        }
+
+        // start-time seeks precisely, the frames before it are decoded but never displayed.
+        // A second full-size decode next to playback: one software decoder thread, the
+        // hardware decoder stays with the player, and nothing but the video track
+        QByteArray startTime = ":start-time=" + QByteArray::number(current.time / 1000.0, 'f', 3);
+        for(const char* option : {":no-audio", ":no-spu", ":no-sub-autodetect-file", ":no-video-title-show",
+            ":avcodec-threads=1", ":avcodec-hw=none", startTime.constData()})
+        {
+            libvlc_media_add_option(media, option);
+        }
+
+        player = libvlc_media_player_new_from_media(media);
+        libvlc_media_release(media);
+        if(! player)
+        {
+            emit captureFinished(current.request, 0);
+            continue;
+        }
+
+        libvlc_video_set_callbacks(player, lockCallback, unlockCallback, displayCallback, this);
+        libvlc_video_set_format_callbacks(player, formatCallback, nullptr);
+
+        nextTime.store(current.time);
+        captureTimeout.start(CAPTURE_TIMEOUT + current.count * current.interval);
+        libvlc_media_player_play(player);
+    }
+}
+
+void SnapshotGrabber::finish()
+{
+    captureTimeout.stop();
+    nextTime.store(NO_FRAME_WANTED);
+
+    if(player)
+    {
+        // stop joins the video output thread, no callback runs after it
+        libvlc_media_player_stop(player);
+        libvlc_media_player_release(player);
+        player = nullptr;
+    }
+
+    emit captureFinished(current.request, captured);
+    startNext();
+}
+
+void SnapshotGrabber::onFrame(int frameSession, qint64 time, const QImage &image)
+{
+    if(frameSession != session || ! player)
+        return;
+
+    emit frameCaptured(current.request, captured, time, image);
+
+    if(++captured >= current.count)
+        finish();
+    else
+        nextTime.store(current.time + qint64(captured) * current.interval);
+}
+
+unsigned SnapshotGrabber::formatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                         unsigned *pitches, unsigned *lines)
+{
+    SnapshotGrabber* self = static_cast<SnapshotGrabber*>(*opaque);
+
+    // native size, libvlc only converts the chroma
+    std::memcpy(chroma, "RV32", 4);
+    *pitches = *width * 4;
+    *lines = *height;
+
+    QMutexLocker locker(&self->frameMutex);
+    self->frame = QImage(int(*width), int(*height), QImage::Format_RGB32);
+    return 1;
+}
+
+void *SnapshotGrabber::lockCallback(void *opaque, void **planes)
+{
+    SnapshotGrabber* self = static_cast<SnapshotGrabber*>(opaque);
+    self->frameMutex.lock();
+    planes[0] = self->frame.bits();
+    return nullptr;
+}
+
+void SnapshotGrabber::unlockCallback(void *opaque, void *picture, void *const *planes)
+{
+    Q_UNUSED(picture)
+    Q_UNUSED(planes)
+    static_cast<SnapshotGrabber*>(opaque)->frameMutex.unlock();
+}
+
+void SnapshotGrabber::displayCallback(void *opaque, void *picture)
+{
+    Q_UNUSED(picture)
+    SnapshotGrabber* self = static_cast<SnapshotGrabber*>(opaque);
+
+    // only the wanted frames are copied, the rest of the burst just plays through
+    qint64 time = libvlc_media_player_get_time(self->player);
+    qint64 wanted = self->nextTime.load();
+    if(wanted == NO_FRAME_WANTED || time + FRAME_TOLERANCE < wanted)
+        return;
+
+    // nothing more until the grabber thread asks for the next one
+    self->nextTime.store(NO_FRAME_WANTED);
+
+    QImage image;
+    {
+        QMutexLocker locker(&self->frameMutex);
+        image = self->frame.copy();
+    }
+
+    int frameSession = self->session;
+    QMetaObject::invokeMethod(self, [self, frameSession, time, image] { self->onFrame(frameSession, time, image); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,85 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef SNAPSHOTGRABBER_H
+#define SNAPSHOTGRABBER_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QTimer>
+#include <atomic>
+
+#include <vlc/vlc.h>
+
+// Captures full-size frames for snapshots with a headless libvlc player.
+// A capture starts the file exactly at the requested time and keeps every
+// interval-th millisecond of playback until count frames are taken, so a
+// burst follows the same timeline as the visible player without touching it.
+// Lives in its own thread; captures are queued and run one after another.
+class SnapshotGrabber : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SnapshotGrabber(libvlc_instance_t* instance, QObject *parent = nullptr);
+    ~SnapshotGrabber();
+
+public slots:
+    void capture(int request, const QString& filePath, qint64 time, int count, int interval);
+    void stop();
+
+signals:
+    void frameCaptured(int request, int index, qint64 time, const QImage& image);
+    void captureFinished(int request, int captured);
+
+private:
+    struct Capture
+    {
+        int request;
+        QString filePath;
+        qint64 time;
+        int count;
+        int interval;
+    };
+
+    static unsigned formatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                   unsigned *pitches, unsigned *lines);
+    static void *lockCallback(void *opaque, void **planes);
+    static void unlockCallback(void *opaque, void *picture, void *const *planes);
+    static void displayCallback(void *opaque, void *picture);
+
+    void startNext();
+    void finish();
+    void onFrame(int session, qint64 time, const QImage& image);
+
+    libvlc_instance_t* instance;
+    libvlc_media_player_t* player;
+    QQueue<Capture> queue;
+    Capture current;
+    int session;
+    int captured;
+    QTimer captureTimeout;
+
+    // shared with the libvlc video output thread
+    std::atomic<qint64> nextTime;
+    QMutex frameMutex;
+    QImage frame;
+};
+
+#endif // SNAPSHOTGRABBER_H
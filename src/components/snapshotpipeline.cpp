@@ -0,0 +1,236 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "snapshotpipeline.h"
+#include "snapshotgrabber.h"
+#include "framepool.h"
+
+#include <QClipboard>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QImageWriter>
+#include <QRunnable>
+#include <QTimer>
+#include <functional>
+
+#include "vlcqt/Instance.h"
+
+const int JPEG_QUALITY = 92;
+const int WEBP_QUALITY = 90;
+
+class SnapshotEncodeTask : public QRunnable
+{
+public:
+    SnapshotEncodeTask(const QImage& image, const QString& filePath, const QString& format,
+                       const QElapsedTimer& requested, const std::function<void(bool, qint64)>& done)
+        : image(image),
+          filePath(filePath),
+          format(format),
+          requested(requested),
+          done(done)
+    {
+    }
+
+    void run() override
+    {
+        QImageWriter writer(filePath, format.toLatin1());
+        if(format == "jpg")
+            writer.setQuality(JPEG_QUALITY);
+        else if(format == "webp")
+            writer.setQuality(WEBP_QUALITY);
+
+        bool written = writer.write(image);
+        if(! written)
+            qWarning() << "Snapshot:" << filePath << "not written:" << writer.errorString();
+
+        done(written, requested.elapsed());
+    }
+
+private:
+    QImage image;
+    QString filePath;
+    QString format;
+    QElapsedTimer requested;
+    std::function<void(bool, qint64)> done;
+};
+
+SnapshotPipeline::SnapshotPipeline(VlcInstance *instance, QObject *parent)
+    : QObject(parent),
+      grabber(new SnapshotGrabber(instance->core())),
+      nextRequest(0),
+      mFormat("png"),
+      mCopyToClipboard(false)
+{
+    // encoding a full-size PNG takes long enough to be worth a few threads, but never all of them
+    encoders.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+
+    grabber->moveToThread(&grabberThread);
+    connect(&grabberThread, &QThread::finished, grabber, &QObject::deleteLater);
+    connect(grabber, &SnapshotGrabber::frameCaptured, this, &SnapshotPipeline::onFrameCaptured);
+    connect(grabber, &SnapshotGrabber::captureFinished, this, [this] (int request, int captured)
+    {
+        // the entry is only needed to name the frames, the encodes have their own copies
+        Request finished = requests.take(request);
+        if(captured < finished.count)
+            emit snapshotFailed(finished.basePath);
+    });
+    grabberThread.setObjectName("Snapshot grabber");
+    grabberThread.start(QThread::LowPriority);
+}
+
+SnapshotPipeline::~SnapshotPipeline()
+{
+    SnapshotGrabber* target = grabber;
+    QMetaObject::invokeMethod(grabber, [target] { target->stop(); }, Qt::BlockingQueuedConnection);
+    grabberThread.quit();
+    grabberThread.wait();
+}
+
+void SnapshotPipeline::take(const QString &mediaPath, qint64 time, int count, int interval)
+{
+    int request = addRequest(mediaPath, count);
+    SnapshotGrabber* target = grabber;
+    QMetaObject::invokeMethod(grabber, [target, request, mediaPath, time, count, interval]
+    {
+        target->capture(request, mediaPath, time, count, interval);
+    });
+}
+
+void SnapshotPipeline::takeFrame(const QString &mediaPath, const QImage &frame)
+{
+    // a frame already on hand, e.g. from the frame pool: only the encode is left to do
+    int request = addRequest(mediaPath, 1);
+    onFrameCaptured(request, 0, 0, frame);
+    requests.remove(request);
+}
+
+void SnapshotPipeline::takeBurst(const QString &mediaPath, FramePool *pool, int count, int interval)
+{
+    // the frames the player decodes anyway, the file is not decoded a second time
+    int request = addRequest(mediaPath, qMax(1, count));
+    QTimer* timer = new QTimer(this);
+    timer->setInterval(qMax(0, interval));
+
+    auto takeNext = [this, pool, request, timer]
+    {
+        Request& entry = requests[request];
+        int index = entry.taken++;
+        bool last = entry.taken >= entry.count;
+        onFrameCaptured(request, index, 0, pool->latestFrame());
+
+        if(last)
+        {
+            timer->stop();
+            timer->deleteLater();
+            requests.remove(request);
+        }
+    };
+    connect(timer, &QTimer::timeout, this, takeNext);
+
+    takeNext();
+    if(requests.contains(request))
+        timer->start();
+}
+
+QString SnapshotPipeline::format() const
+{
+    return mFormat;
+}
+
+void SnapshotPipeline::setFormat(const QString &format)
+{
+    if(supportedFormats().contains(format))
+        mFormat = format;
+}
+
+bool SnapshotPipeline::copiesToClipboard() const
+{
+    return mCopyToClipboard;
+}
+
+void SnapshotPipeline::setCopyToClipboard(bool copy)
+{
+    mCopyToClipboard = copy;
+}
+
+QString SnapshotPipeline::outputFolder() const
+{
+    return mOutputFolder;
+}
+
+void SnapshotPipeline::setOutputFolder(const QString &folder)
+{
+    mOutputFolder = folder;
+}
+
+QStringList SnapshotPipeline::supportedFormats()
+{
+    // webp needs the qtimageformats plugin, which is not always deployed
+    QStringList formats = {"png", "jpg"};
+    if(QImageWriter::supportedImageFormats().contains("webp"))
+        formats.append("webp");
+    return formats;
+}
+
+int SnapshotPipeline::addRequest(const QString &mediaPath, int count)
+{
+    int request = nextRequest++;
+
+    Request& entry = requests[request];
+    QString base = mOutputFolder.isEmpty() ? mediaPath : QDir(mOutputFolder).filePath(QFileInfo(mediaPath).fileName());
+    entry.basePath = base + "-" + QDateTime::currentDateTime().toString(Qt::ISODateWithMs).remove(":");
+    entry.format = mFormat;
+    entry.clipboard = mCopyToClipboard;
+    entry.count = count;
+    entry.taken = 0;
+    entry.requested.start();
+
+    return request;
+}
+
+void SnapshotPipeline::onFrameCaptured(int request, int index, qint64 time, const QImage &image)
+{
+    Q_UNUSED(time)
+
+    auto found = requests.constFind(request);
+    if(found == requests.constEnd())
+        return;
+
+    const Request& entry = found.value();
+    QString filePath = entry.basePath + (entry.count > 1 ? QString("-%1").arg(index + 1, 2, 10, QChar('0')) : QString()) +
+            "." + entry.format;
+
+    if(entry.clipboard && index == 0)
+        QGuiApplication::clipboard()->setImage(image);
+
+    auto done = [this, filePath] (bool written, qint64 latency)
+    {
+        QMetaObject::invokeMethod(this, [this, filePath, written, latency]
+        {
+            if(written)
+                emit snapshotSaved(filePath, latency);
+            else
+                emit snapshotFailed(filePath);
+        });
+    };
+
+    encoders.start(new SnapshotEncodeTask(image, filePath, entry.format, entry.requested, done));
+}
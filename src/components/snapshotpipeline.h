@@ -0,0 +1,86 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef SNAPSHOTPIPELINE_H
+#define SNAPSHOTPIPELINE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QThread>
+#include <QThreadPool>
+
+class SnapshotGrabber;
+class FramePool;
+class VlcInstance;
+
+// Snapshots that never block playback or the GUI: frames come from a
+// SnapshotGrabber in its own thread and are encoded and written by a small
+// worker pool. A burst takes count frames interval ms apart, from the frame
+// pool when the player renders through one. Files go next to the media or
+// to the output folder. Every saved file reports the time from the request
+// to the file being written.
+class SnapshotPipeline : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SnapshotPipeline(VlcInstance* instance, QObject *parent = nullptr);
+    ~SnapshotPipeline();
+
+    void take(const QString& mediaPath, qint64 time, int count = 1, int interval = 0);
+    void takeFrame(const QString& mediaPath, const QImage& frame);
+    void takeBurst(const QString& mediaPath, FramePool* pool, int count, int interval);
+    QString format() const;
+    void setFormat(const QString& format);
+    bool copiesToClipboard() const;
+    void setCopyToClipboard(bool copy);
+    QString outputFolder() const;
+    void setOutputFolder(const QString& folder);
+
+    static QStringList supportedFormats();
+
+signals:
+    void snapshotSaved(const QString& filePath, qint64 latency);
+    void snapshotFailed(const QString& filePath);
+
+private:
+    struct Request
+    {
+        QString basePath;
+        QString format;
+        bool clipboard;
+        int count;
+        int taken;      // bursts from the frame pool only
+        QElapsedTimer requested;
+    };
+
+    int addRequest(const QString& mediaPath, int count);
+    void onFrameCaptured(int request, int index, qint64 time, const QImage& image);
+
+    QThread grabberThread;
+    SnapshotGrabber* grabber;
+    QHash<int, Request> requests;
+    int nextRequest;
+    QString mFormat;
+    bool mCopyToClipboard;
+    QString mOutputFolder;  // empty: next to the media
+    QThreadPool encoders; // declared last so its destructor waits for running encodes first
+};
+
+#endif // SNAPSHOTPIPELINE_H
@@ -0,0 +1,187 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "spritesheetgenerator.h"
+#include "framegrabber.h"
+
+#include <QBuffer>
+#include <QDebug>
+
+#include "vlcqt/Instance.h"
+#include "../spritesheet.h"
+
+const int TILE_WIDTH = 160;
+const int TILE_QUALITY = 70;
+const qint64 SPRITE_CACHE_BYTES = 256 * 1024 * 1024;
+
+SpriteSheetGenerator::SpriteSheetGenerator(VlcInstance *instance, QObject *parent)
+    : QObject(parent),
+      grabber(new FrameGrabber(instance->core(), TILE_WIDTH)),
+      interval(0),
+      tileTotal(0),
+      generation(0),
+      running(false),
+      idle(false),
+      grabberOpened(false),
+      waiting(false)
+{
+    grabber->moveToThread(&grabberThread);
+    connect(&grabberThread, &QThread::finished, grabber, &QObject::deleteLater);
+
+    // the tile is encoded in the grabber thread, only the JPEG bytes come back
+    connect(grabber, &FrameGrabber::frameGrabbed, this, [this] (int frameGeneration, qint64, const QImage& image)
+    {
+        QByteArray jpeg;
+        QBuffer buffer(&jpeg);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "JPG", TILE_QUALITY);
+        QMetaObject::invokeMethod(this, [this, frameGeneration, jpeg] { addTile(frameGeneration, jpeg); });
+    }, Qt::DirectConnection);
+
+    // e.g. nothing left to show near the end, the tile stays empty and previews fall back to live grabs
+    connect(grabber, &FrameGrabber::grabFailed, this, [this] (int frameGeneration, qint64)
+    {
+        // nothing at the very start means the file did not open or decode, there is no sheet to build
+        if(frameGeneration == generation && running && tiles.isEmpty())
+        {
+            qWarning() << "Sprite sheet: no first tile for" << mediaPath;
+            cancel();
+            return;
+        }
+        addTile(frameGeneration, QByteArray());
+    });
+
+    grabberThread.setObjectName("Sprite sheet grabber");
+    grabberThread.start(QThread::IdlePriority);
+}
+
+SpriteSheetGenerator::~SpriteSheetGenerator()
+{
+    FrameGrabber* target = grabber;
+    QMetaObject::invokeMethod(grabber, [target] { target->close(); }, Qt::BlockingQueuedConnection);
+    grabberThread.quit();
+    grabberThread.wait();
+}
+
+void SpriteSheetGenerator::start(const QString &filePath, qint64 length)
+{
+    // the video output can come up more than once for the same file
+    if(running && filePath == mediaPath)
+        return;
+
+    cancel();
+
+    if(length <= 0)
+        return;
+
+    mediaPath = filePath;
+    interval = SpriteSheet::intervalFor(length);
+    tileTotal = int((length + interval - 1) / interval);
+    tiles.reserve(tileTotal);
+    running = true;
+    timer.start();
+
+    grabNext();
+}
+
+void SpriteSheetGenerator::cancel()
+{
+    ++generation;
+    running = false;
+    waiting = false;
+    tiles.clear();
+
+    if(grabberOpened)
+    {
+        FrameGrabber* target = grabber;
+        QMetaObject::invokeMethod(grabber, [target] { target->close(); });
+        grabberOpened = false;
+    }
+}
+
+void SpriteSheetGenerator::setIdle(bool isIdle)
+{
+    idle = isIdle;
+    grabNext();
+}
+
+void SpriteSheetGenerator::grabNext()
+{
+    // a tile in flight is finished even if playback resumed, the next one waits for idle
+    if(! running || ! idle || waiting)
+        return;
+
+    FrameGrabber* target = grabber;
+    if(! grabberOpened)
+    {
+        int openGeneration = generation;
+        QString path = mediaPath;
+        QMetaObject::invokeMethod(grabber, [target, openGeneration, path] { target->open(openGeneration, path); });
+        grabberOpened = true;
+    }
+
+    qint64 time = tiles.size() * interval;
+    waiting = true;
+    QMetaObject::invokeMethod(grabber, [target, time] { target->grab(time); });
+}
+
+void SpriteSheetGenerator::addTile(int tileGeneration, const QByteArray &jpeg)
+{
+    if(tileGeneration != generation || ! running)
+        return;
+
+    waiting = false;
+    tiles.append(jpeg);
+
+    if(tiles.size() >= tileTotal)
+        finish();
+    else
+        grabNext();
+}
+
+void SpriteSheetGenerator::finish()
+{
+    qInfo() << "Sprite sheet:" << tiles.size() << "tiles in" << timer.elapsed() << "ms for" << mediaPath;
+
+    running = false;
+    grabberOpened = false;
+
+    // the file is written from the grabber thread, which is idle by now
+    FrameGrabber* target = grabber;
+    QString path = mediaPath;
+    QVector<QByteArray> sheetTiles = tiles;
+    qint64 sheetInterval = interval;
+    int sheetGeneration = generation;
+    tiles.clear();
+
+    QMetaObject::invokeMethod(grabber, [this, target, path, sheetTiles, sheetInterval, sheetGeneration]
+    {
+        target->close();
+        bool saved = SpriteSheet::save(path, sheetInterval, sheetTiles);
+        SpriteSheet::evictCache(SPRITE_CACHE_BYTES);
+
+        if(saved)
+        {
+            QMetaObject::invokeMethod(this, [this, path, sheetGeneration]
+            {
+                if(sheetGeneration == generation)
+                    emit generated(path);
+            });
+        }
+    });
+}
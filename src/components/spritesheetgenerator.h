@@ -0,0 +1,66 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef SPRITESHEETGENERATOR_H
+#define SPRITESHEETGENERATOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QThread>
+#include <QVector>
+
+class FrameGrabber;
+class VlcInstance;
+
+// Builds the SpriteSheet of a file with its own FrameGrabber, one tile at a
+// time and only while the player is idle, then saves it to the disk cache.
+class SpriteSheetGenerator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SpriteSheetGenerator(VlcInstance* instance, QObject *parent = nullptr);
+    ~SpriteSheetGenerator();
+
+    void start(const QString& filePath, qint64 length);
+    void cancel();
+    void setIdle(bool idle);
+
+signals:
+    void generated(const QString& filePath);
+
+private:
+    void grabNext();
+    void addTile(int generation, const QByteArray& jpeg);
+    void finish();
+
+    QThread grabberThread;
+    FrameGrabber* grabber;
+    QString mediaPath;
+    QVector<QByteArray> tiles;
+    QElapsedTimer timer;
+    qint64 interval;
+    int tileTotal;
+    int generation;
+    bool running;
+    bool idle;
+    bool grabberOpened;
+    bool waiting;
+};
+
+#endif // SPRITESHEETGENERATOR_H
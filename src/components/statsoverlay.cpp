@@ -0,0 +1,160 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "statsoverlay.h"
+
+#include <QPainter>
+
+const int ROW_HEIGHT = 28;
+const int LABEL_WIDTH = 150;
+const int SPARKLINE_WIDTH = PlaybackStatsSampler::HISTORY_SIZE;
+const int MARGIN = 10;
+
+StatsOverlay::StatsOverlay()
+{
+    setWindowFlags(Qt::FramelessWindowHint | Qt::Tool | Qt::WindowStaysOnTopHint);
+    setAttribute(Qt::WA_TranslucentBackground);
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+
+    setFixedSize(LABEL_WIDTH + SPARKLINE_WIDTH + 3 * MARGIN, METRIC_COUNT * ROW_HEIGHT + 2 * MARGIN);
+
+    statsSampler = nullptr;
+    viewWidget = nullptr;
+}
+
+void StatsOverlay::setSampler(PlaybackStatsSampler *sampler)
+{
+    if(statsSampler)
+        disconnect(statsSampler, &PlaybackStatsSampler::sampled, this, nullptr);
+
+    statsSampler = sampler;
+
+    if(statsSampler)
+    {
+        connect(statsSampler, &PlaybackStatsSampler::sampled, this, [this]
+        {
+            if(isVisible())
+                update();
+        });
+    }
+}
+
+void StatsOverlay::setViewWidget(QWidget *widget)
+{
+    viewWidget = widget;
+    adjustPositionToParent();
+}
+
+void StatsOverlay::adjustPositionToParent()
+{
+    if(viewWidget)
+    {
+        QPoint globalTopLeft = viewWidget->mapToGlobal(QPoint(0, 0));
+        this->move(globalTopLeft.x() + MARGIN, globalTopLeft.y() + MARGIN);
+    }
+}
+
+void StatsOverlay::toggle()
+{
+    if(isVisible())
+    {
+        hide();
+    }
+    else
+    {
+        adjustPositionToParent();
+        show();
+    }
+}
+
+float StatsOverlay::metricValue(const PlaybackStatsSample &sample, Metric metric)
+{
+    switch (metric)
+    {
+    case INPUT_BITRATE:
+        return sample.inputBitrate;
+    case DEMUX_BITRATE:
+        return sample.demuxBitrate;
+    case DECODED_VIDEO:
+        return sample.decodedVideo;
+    case DISPLAYED_PICTURES:
+        return sample.displayedPictures;
+    case LOST_PICTURES:
+        return sample.lostPictures;
+    case LOST_AUDIO_BUFFERS:
+        return sample.lostAudioBuffers;
+    case CPU_USAGE:
+        return sample.cpuUsage;
+    case GUI_STALLS:
+        return sample.guiStalls;
+    default:
+        return 0;
+    }
+}
+
+void StatsOverlay::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    static const char* labels[METRIC_COUNT] = {"Input bitrate (kb/s)", "Demux bitrate (kb/s)", "Decoded frames",
+                                               "Displayed frames", "Lost frames", "Lost audio buffers",
+                                               "CPU (%)", "GUI stalls"
+                                              };
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(20, 20, 20, 200));
+    painter.drawRoundedRect(rect(), 10, 10);
+
+    if(statsSampler == nullptr)
+        return;
+
+    const PlaybackStatsSampler::History& history = statsSampler->history();
+    QPointF points[PlaybackStatsSampler::HISTORY_SIZE];
+
+    for(int m = 0; m < METRIC_COUNT; ++m)
+    {
+        Metric metric = Metric(m);
+        int top = MARGIN + m * ROW_HEIGHT;
+        QString current = history.isEmpty() ? "--" : QString::number(metricValue(history.last(), metric), 'f', 0);
+
+        painter.setPen(Qt::white);
+        painter.drawText(QRect(MARGIN, top, LABEL_WIDTH, ROW_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter,
+                         QString("%1: %2").arg(labels[m], current));
+
+        if(history.size() < 2)
+            continue;
+
+        float maxValue = 1;
+        for(std::size_t i = 0; i < history.size(); ++i)
+            maxValue = qMax(maxValue, metricValue(history.at(i), metric));
+
+        int left = 2 * MARGIN + LABEL_WIDTH + SPARKLINE_WIDTH - int(history.size());
+        int bottom = top + ROW_HEIGHT - 4;
+        int height = ROW_HEIGHT - 8;
+
+        for(std::size_t i = 0; i < history.size(); ++i)
+            points[i] = QPointF(left + i, bottom - (metricValue(history.at(i), metric) / maxValue) * height);
+
+        bool isLoss = (metric == LOST_PICTURES || metric == LOST_AUDIO_BUFFERS || metric == GUI_STALLS);
+        painter.setPen(QPen(isLoss ? QColor(231, 76, 60) : QColor(83, 173, 203), 1));
+        painter.drawPolyline(points, int(history.size()));
+    }
+}
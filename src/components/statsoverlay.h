@@ -0,0 +1,61 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef STATSOVERLAY_H
+#define STATSOVERLAY_H
+
+#include <QWidget>
+
+#include "playbackstats.h"
+
+class StatsOverlay : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit StatsOverlay();
+
+    void setSampler(PlaybackStatsSampler* sampler);
+    void setViewWidget(QWidget* widget);
+    void adjustPositionToParent();
+
+public slots:
+    void toggle();
+
+private:
+    enum Metric
+    {
+        INPUT_BITRATE,
+        DEMUX_BITRATE,
+        DECODED_VIDEO,
+        DISPLAYED_PICTURES,
+        LOST_PICTURES,
+        LOST_AUDIO_BUFFERS,
+        CPU_USAGE,
+        GUI_STALLS,
+        METRIC_COUNT
+    };
+
+    static float metricValue(const PlaybackStatsSample& sample, Metric metric);
+
+    PlaybackStatsSampler* statsSampler;
+    QWidget* viewWidget;
+
+    void paintEvent(QPaintEvent *event) override;
+};
+
+#endif // STATSOVERLAY_H
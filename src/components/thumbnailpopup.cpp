@@ -0,0 +1,95 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "thumbnailpopup.h"
+
+#include <QPainter>
+#include <QScreen>
+#include <QGuiApplication>
+
+const int PREVIEW_WIDTH = 160;
+const int TEXT_HEIGHT = 34;
+const int BORDER = 2;
+const int DISTANCE_FROM_SLIDER = 6;
+
+ThumbnailPopup::ThumbnailPopup(QWidget *parent)
+    : QWidget(parent)
+{
+    setWindowFlags(Qt::ToolTip | Qt::FramelessWindowHint);
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+}
+
+void ThumbnailPopup::showPreview(const QPoint &globalBottomCenter, const QImage &newImage, const QString &newText)
+{
+    // keep the last frame while the new one is being grabbed, better than flashing an empty box
+    if(! newImage.isNull())
+        image = newImage;
+    text = newText;
+    anchor = globalBottomCenter;
+
+    updateGeometryFor(globalBottomCenter);
+    if(! isVisible())
+        show();
+    update();
+}
+
+void ThumbnailPopup::setImage(const QImage &newImage)
+{
+    bool sizeChanged = newImage.size() != image.size();
+    image = newImage;
+
+    if(sizeChanged)
+        updateGeometryFor(anchor);
+    update();
+}
+
+void ThumbnailPopup::updateGeometryFor(const QPoint &globalBottomCenter)
+{
+    int imageHeight = image.isNull() ? 0 : image.height() * PREVIEW_WIDTH / image.width();
+    QSize size(PREVIEW_WIDTH + 2 * BORDER, imageHeight + TEXT_HEIGHT + 2 * BORDER);
+    QRect rect(QPoint(globalBottomCenter.x() - size.width() / 2,
+                      globalBottomCenter.y() - size.height() - DISTANCE_FROM_SLIDER), size);
+
+    if(QScreen* screen = QGuiApplication::screenAt(globalBottomCenter))
+    {
+        QRect available = screen->availableGeometry();
+        rect.moveLeft(qBound(available.left(), rect.left(), available.right() - rect.width()));
+    }
+
+    setGeometry(rect);
+}
+
+void ThumbnailPopup::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(10, 10, 10));
+
+    QRect imageRect(BORDER, BORDER, width() - 2 * BORDER, height() - TEXT_HEIGHT - 2 * BORDER);
+    if(! image.isNull() && imageRect.height() > 0)
+    {
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(imageRect, image);
+    }
+
+    painter.setPen(QColor(0x34, 0x98, 0xDB));
+    painter.drawText(QRect(BORDER, height() - TEXT_HEIGHT - BORDER, width() - 2 * BORDER, TEXT_HEIGHT),
+                     Qt::AlignCenter | Qt::TextWordWrap, text);
+}
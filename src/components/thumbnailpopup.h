@@ -0,0 +1,45 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef THUMBNAILPOPUP_H
+#define THUMBNAILPOPUP_H
+
+#include <QWidget>
+#include <QImage>
+
+// The preview shown above the progress slider: a frame (when there is one
+// yet) and the hovered time and chapter below it.
+class ThumbnailPopup : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ThumbnailPopup(QWidget *parent = nullptr);
+
+    void showPreview(const QPoint& globalBottomCenter, const QImage& image, const QString& text);
+    void setImage(const QImage& image);
+
+private:
+    void paintEvent(QPaintEvent *event) override;
+    void updateGeometryFor(const QPoint& globalBottomCenter);
+
+    QImage image;
+    QString text;
+    QPoint anchor;
+};
+
+#endif // THUMBNAILPOPUP_H
@@ -0,0 +1,169 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "thumbnailprovider.h"
+#include "framegrabber.h"
+#include "spritesheetgenerator.h"
+
+#include "vlcqt/Instance.h"
+
+const int THUMBNAIL_WIDTH = 160;
+const int THUMBNAIL_CACHE_BYTES = 16 * 1024 * 1024;
+// without a keyframe index the previews are taken every few seconds
+const qint64 SLOT_LENGTH = 5000;
+
+ThumbnailProvider::ThumbnailProvider(VlcInstance *instance, QObject *parent)
+    : QObject(parent),
+      grabber(new FrameGrabber(instance->core(), THUMBNAIL_WIDTH)),
+      sheetGenerator(new SpriteSheetGenerator(instance, this)),
+      cache(THUMBNAIL_CACHE_BYTES),
+      generation(0),
+      grabberOpened(false),
+      requestedSlot(-1)
+{
+    grabber->moveToThread(&grabberThread);
+    connect(&grabberThread, &QThread::finished, grabber, &QObject::deleteLater);
+    connect(grabber, &FrameGrabber::frameGrabbed, this, &ThumbnailProvider::onFrameGrabbed);
+    connect(sheetGenerator, &SpriteSheetGenerator::generated, this, &ThumbnailProvider::onSpriteSheetGenerated);
+    grabberThread.setObjectName("Thumbnail grabber");
+    grabberThread.start(QThread::LowPriority);
+}
+
+ThumbnailProvider::~ThumbnailProvider()
+{
+    FrameGrabber* target = grabber;
+    QMetaObject::invokeMethod(grabber, [target] { target->close(); }, Qt::BlockingQueuedConnection);
+    grabberThread.quit();
+    grabberThread.wait();
+}
+
+void ThumbnailProvider::setMedia(const QString &filePath)
+{
+    ++generation;
+    mediaPath = filePath;
+    keyframes = KeyframeIndex();
+    cache.clear();
+    requestedSlot = -1;
+
+    sheetGenerator->cancel();
+    sheet = SpriteSheet();
+    if(SpriteSheet::load(filePath, &sheet))
+        emit spriteSheetChanged();
+
+    // the grabber only opens the file once a preview is actually wanted
+    if(grabberOpened)
+    {
+        FrameGrabber* target = grabber;
+        QMetaObject::invokeMethod(grabber, [target] { target->close(); });
+        grabberOpened = false;
+    }
+}
+
+void ThumbnailProvider::setKeyframeIndex(const KeyframeIndex &index)
+{
+    keyframes = index;
+    cache.clear();
+}
+
+void ThumbnailProvider::generateSpriteSheet(qint64 length)
+{
+    if(sheet.isEmpty() && ! mediaPath.isEmpty())
+        sheetGenerator->start(mediaPath, length);
+}
+
+void ThumbnailProvider::setIdle(bool idle)
+{
+    sheetGenerator->setIdle(idle);
+}
+
+bool ThumbnailProvider::hasSpriteSheet() const
+{
+    return ! sheet.isEmpty();
+}
+
+qint64 ThumbnailProvider::slotOf(qint64 time) const
+{
+    if(! sheet.isEmpty())
+        return sheet.tileTime(sheet.tileIndexAt(time));
+
+    // a seek lands on the keyframe before the target anyway, so that is the frame to show
+    if(! keyframes.isEmpty())
+        return keyframes.keyframeAtOrBefore(time);
+
+    return (time / SLOT_LENGTH) * SLOT_LENGTH;
+}
+
+QImage ThumbnailProvider::thumbnail(qint64 time)
+{
+    if(mediaPath.isEmpty())
+        return QImage();
+
+    qint64 slot = slotOf(time);
+    if(QImage* image = cache.object(slot))
+        return *image;
+
+    if(! sheet.isEmpty())
+    {
+        QImage image = sheet.tile(sheet.tileIndexAt(time));
+        if(! image.isNull())
+        {
+            cache.insert(slot, new QImage(image), int(image.sizeInBytes()));
+            return image;
+        }
+    }
+
+    if(slot == requestedSlot)
+        return QImage();
+
+    requestedSlot = slot;
+    FrameGrabber* target = grabber;
+    if(! grabberOpened)
+    {
+        int openGeneration = generation;
+        QString path = mediaPath;
+        QMetaObject::invokeMethod(grabber, [target, openGeneration, path] { target->open(openGeneration, path); });
+        grabberOpened = true;
+    }
+
+    // replaces whatever was asked for before, the mouse has moved on
+    QMetaObject::invokeMethod(grabber, [target, slot] { target->grab(slot); });
+    return QImage();
+}
+
+void ThumbnailProvider::onFrameGrabbed(int frameGeneration, qint64 slot, const QImage &image)
+{
+    if(frameGeneration != generation)
+        return;
+
+    if(slot == requestedSlot)
+        requestedSlot = -1;
+
+    cache.insert(slot, new QImage(image), int(image.sizeInBytes()));
+    emit thumbnailReady(slot, image);
+}
+
+void ThumbnailProvider::onSpriteSheetGenerated(const QString &filePath)
+{
+    if(filePath != mediaPath || ! SpriteSheet::load(filePath, &sheet))
+        return;
+
+    // slots change from keyframes to tiles
+    cache.clear();
+    requestedSlot = -1;
+    emit spriteSheetChanged();
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef THUMBNAILPROVIDER_H
+#define THUMBNAILPROVIDER_H
+
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QThread>
+
+#include "../keyframeindex.h"
+#include "../spritesheet.h"
+
+class FrameGrabber;
+class SpriteSheetGenerator;
+class VlcInstance;
+
+// Seek-bar previews for the current file. They are cropped from the file's
+// cached SpriteSheet when there is one, otherwise frames come from a
+// FrameGrabber running in its own thread; either way they are kept in an
+// LRU cache limited by memory. Missing sprite sheets are generated while idle.
+class ThumbnailProvider : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ThumbnailProvider(VlcInstance* instance, QObject *parent = nullptr);
+    ~ThumbnailProvider();
+
+    void setMedia(const QString& filePath);
+    void setKeyframeIndex(const KeyframeIndex& index);
+    void generateSpriteSheet(qint64 length);
+    void setIdle(bool idle);
+    bool hasSpriteSheet() const;
+    QImage thumbnail(qint64 time);
+    qint64 slotOf(qint64 time) const;
+
+signals:
+    void thumbnailReady(qint64 slot, const QImage& image);
+    void spriteSheetChanged();
+
+private:
+    void onFrameGrabbed(int generation, qint64 slot, const QImage& image);
+    void onSpriteSheetGenerated(const QString& filePath);
+
+    QThread grabberThread;
+    FrameGrabber* grabber;
+    SpriteSheetGenerator* sheetGenerator;
+    QCache<qint64, QImage> cache;
+    KeyframeIndex keyframes;
+    SpriteSheet sheet;
+    QString mediaPath;
+    int generation;
+    bool grabberOpened;
+    qint64 requestedSlot;
+};
+
+#endif // THUMBNAILPROVIDER_H
@@ -19,23 +19,81 @@
 #ifndef VIDEOWIDGET_H
 #define VIDEOWIDGET_H
 
-#include <QVideoWidget>
+#include <QWidget>
 #include <QMouseEvent>
 #include <QPaintEvent>
 #include <QPainter>
 #include <QPainterPath>
+#include <QCursor>
+#include <QResizeEvent>
 #include <QObject>
 
-class VideoWidget : public QVideoWidget
+#include "framepool.h"
+#include "videosurface.h"
+
+// Paints the idle frame or the frames of the pool. Without the pool libvlc
+// renders into a VideoSurface laid over the widget, shown only while there is
+// a video output. Picture-in-picture takes the surface away and gives it back.
+class VideoWidget : public QWidget
 {
     Q_OBJECT
 
 public:
     VideoWidget(QWidget* parent)
-        : QVideoWidget(parent)
+        : QWidget(parent)
     {
         this->setMouseTracking(true);
+        this->setAttribute(Qt::WA_NoSystemBackground);
+        this->setAttribute(Qt::WA_OpaquePaintEvent);
         fullScrren = false;
+        framePool = nullptr;
+        videoSurface = nullptr;
+        surfaceContainer = nullptr;
+        videoOutput = false;
+    }
+
+    // the native window handed to libvlc, created once for the lifetime of the widget
+    VideoSurface* createSurface()
+    {
+        videoSurface = new VideoSurface;
+        surfaceContainer = QWidget::createWindowContainer(videoSurface, this);
+        surfaceContainer->hide();
+        connect(videoSurface, &VideoSurface::mouseMove, this, &VideoWidget::mouseMove);
+        return videoSurface;
+    }
+
+    VideoSurface* surface() const
+    {
+        return videoSurface;
+    }
+
+    // the caller re-parents the container, the native window keeps its handle
+    QWidget* takeSurface()
+    {
+        return surfaceContainer;
+    }
+
+    void restoreSurface()
+    {
+        if(! surfaceContainer)
+            return;
+
+        surfaceContainer->setParent(this);
+        surfaceContainer->setGeometry(this->rect());
+        surfaceContainer->setVisible(videoOutput);
+    }
+
+    // the widget itself is covered by the surface, so it is not told about the mouse over the video
+    bool containsMouse() const
+    {
+        return this->isVisible() && this->rect().contains(this->mapFromGlobal(QCursor::pos()));
+    }
+
+    // paint the frames of the pool instead of leaving the window to libvlc
+    void setFramePool(FramePool* pool)
+    {
+        framePool = pool;
+        connect(framePool, &FramePool::frameReady, this, [this] { this->update(); });
     }
 
     void onFullScreen(bool full)
@@ -43,20 +101,49 @@ public:
         fullScrren = full;
         this->update();
     }
+
+    bool hasVideoOutput() const
+    {
+        return videoOutput;
+    }
+
+    // the surface is only shown while libvlc draws into it
+    void setVideoOutput(bool active)
+    {
+        videoOutput = active;
+        if(surfaceContainer)
+            surfaceContainer->setVisible(active);
+        this->update();
+    }
 signals:
     void mouseMove();
 
 protected:
     bool fullScrren;
+    FramePool* framePool;
+    VideoSurface* videoSurface;
+    QWidget* surfaceContainer;
+    bool videoOutput;
 
+    void resizeEvent(QResizeEvent*) override
+    {
+        if(surfaceContainer && surfaceContainer->parentWidget() == this)
+            surfaceContainer->setGeometry(this->rect());
+    }
     void mouseMoveEvent(QMouseEvent *event) override
     {
         event->ignore();
         emit mouseMove();
     }
-    void paintEvent(QPaintEvent* event) override
+    void paintEvent(QPaintEvent*) override
     {
-        if(! fullScrren)
+        QImage frame = framePool ? framePool->latestFrame() : QImage();
+        if(! frame.isNull())
+        {
+            QPainter p(this);
+            FramePool::paint(&p, this->rect(), frame);
+        }
+        else if(! fullScrren)
         {
             QPainter p(this);
             p.setRenderHint(QPainter::Antialiasing);
@@ -69,7 +156,8 @@ protected:
         }
         else
         {
-            QVideoWidget::paintEvent(event);
+            QPainter p(this);
+            p.fillRect(this->rect(), Qt::black);
         }
     }
 };
@@ -0,0 +1,52 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "videosurface.h"
+#include <QMouseEvent>
+
+VideoSurface::VideoSurface(QWindow *parent)
+    : QWindow(parent)
+{
+    // the shortcuts live on the widgets, the surface never takes the focus from them
+    this->setFlags(Qt::WindowDoesNotAcceptFocus);
+    measuring = false;
+}
+
+void VideoSurface::startMeasuring()
+{
+    measuring = true;
+    switchTimer.start();
+}
+
+void VideoSurface::exposeEvent(QExposeEvent *event)
+{
+    QWindow::exposeEvent(event);
+
+    // libvlc keeps drawing into the window, once it is exposed again the video is on screen
+    if(measuring && this->isExposed())
+    {
+        measuring = false;
+        emit firstExpose(switchTimer.nsecsElapsed() / 1000000.0);
+    }
+}
+
+void VideoSurface::mouseMoveEvent(QMouseEvent *event)
+{
+    event->ignore();
+    emit mouseMove();
+}
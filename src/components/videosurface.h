@@ -0,0 +1,51 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef VIDEOSURFACE_H
+#define VIDEOSURFACE_H
+
+#include <QWindow>
+#include <QElapsedTimer>
+
+// The native window libvlc renders into. Its handle is given to libvlc once
+// and never changes: picture-in-picture moves the widget container holding
+// it, which only re-parents the native window. Clicks and wheel turns are
+// picked up by MainPage::watchVideoView(), mouse moves are reported here.
+// After startMeasuring() the next expose reports how long it took to get there.
+class VideoSurface : public QWindow
+{
+    Q_OBJECT
+public:
+    explicit VideoSurface(QWindow *parent = nullptr);
+
+    void startMeasuring();
+
+signals:
+    void mouseMove();
+    void firstExpose(double elapsed);
+
+protected:
+    void exposeEvent(QExposeEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    QElapsedTimer switchTimer;
+    bool measuring;
+};
+
+#endif // VIDEOSURFACE_H
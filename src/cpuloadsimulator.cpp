@@ -0,0 +1,75 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "cpuloadsimulator.h"
+
+#include <QThread>
+#include <QDebug>
+
+CpuLoadSimulator::CpuLoadSimulator()
+    : running(false)
+{
+}
+
+CpuLoadSimulator::~CpuLoadSimulator()
+{
+    stop();
+}
+
+void CpuLoadSimulator::start(int threadCount)
+{
+    if(running)
+        return;
+
+    if(threadCount <= 0)
+        threadCount = QThread::idealThreadCount();
+
+    running = true;
+
+    for(int i = 0; i < threadCount; ++i)
+    {
+        workers.emplace_back([this]
+        {
+            volatile unsigned long long spin = 0;
+            while(running.load(std::memory_order_relaxed))
+                ++spin;
+        });
+    }
+
+    qInfo() << "CPU load simulator: started" << threadCount << "busy threads";
+}
+
+void CpuLoadSimulator::stop()
+{
+    if(! running)
+        return;
+
+    running = false;
+
+    for(auto& worker : workers)
+        worker.join();
+
+    workers.clear();
+
+    qInfo() << "CPU load simulator: stopped";
+}
+
+bool CpuLoadSimulator::isRunning() const
+{
+    return running;
+}
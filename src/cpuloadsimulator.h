@@ -0,0 +1,42 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef CPULOADSIMULATOR_H
+#define CPULOADSIMULATOR_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Keeps every core busy so the decode governor can be exercised on a fast machine.
+class CpuLoadSimulator
+{
+public:
+    CpuLoadSimulator();
+    ~CpuLoadSimulator();
+
+    void start(int threadCount = 0);
+    void stop();
+    bool isRunning() const;
+
+private:
+    std::vector<std::thread> workers;
+    std::atomic<bool> running;
+};
+
+#endif // CPULOADSIMULATOR_H
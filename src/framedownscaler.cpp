@@ -0,0 +1,111 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "framedownscaler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRAMEDOWNSCALER_SSE2
+#include <emmintrin.h>
+#endif
+
+const QImage &FrameDownscaler::downscale(const QImage &frame, const QSize &minimumSize)
+{
+    int halvings = 0;
+    QSize size = frame.size();
+    while(size.width() / 2 >= minimumSize.width() && size.height() / 2 >= minimumSize.height() &&
+          size.width() >= 4 && size.height() >= 2)
+    {
+        size /= 2;
+        ++halvings;
+    }
+
+    if(halvings == 0)
+        return frame;
+
+    if(stages.size() < halvings)
+        stages.resize(halvings);
+
+    const QImage* source = &frame;
+    for(int i = 0; i < halvings; ++i)
+    {
+        halve(*source, &stages[i]);
+        source = &stages[i];
+    }
+
+    return stages[halvings - 1];
+}
+
+void FrameDownscaler::halve(const QImage &source, QImage *target)
+{
+    const int width = source.width() / 2;
+    const int height = source.height() / 2;
+
+    if(target->width() != width || target->height() != height || target->format() != QImage::Format_RGB32)
+        *target = QImage(width, height, QImage::Format_RGB32);
+
+    const int sourceStride = source.bytesPerLine();
+    const uchar* sourceBits = source.constBits();
+
+    for(int y = 0; y < height; ++y)
+    {
+        const quint32* top = reinterpret_cast<const quint32*>(sourceBits + (2 * y) * sourceStride);
+        const quint32* bottom = reinterpret_cast<const quint32*>(sourceBits + (2 * y + 1) * sourceStride);
+        quint32* out = reinterpret_cast<quint32*>(target->scanLine(y));
+        int x = 0;
+
+#ifdef FRAMEDOWNSCALER_SSE2
+        // 4 output pixels per step: widen to 16 bits, add the 2x2 block, round, divide by 4
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i two = _mm_set1_epi16(2);
+        for(; x + 4 <= width; x += 4)
+        {
+            __m128i top0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 2 * x));
+            __m128i top1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 2 * x + 4));
+            __m128i bottom0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 2 * x));
+            __m128i bottom1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 2 * x + 4));
+
+            // vertical sums, pixels 0-1, 2-3, 4-5 and 6-7 of the pair of rows
+            __m128i sum0 = _mm_add_epi16(_mm_unpacklo_epi8(top0, zero), _mm_unpacklo_epi8(bottom0, zero));
+            __m128i sum1 = _mm_add_epi16(_mm_unpackhi_epi8(top0, zero), _mm_unpackhi_epi8(bottom0, zero));
+            __m128i sum2 = _mm_add_epi16(_mm_unpacklo_epi8(top1, zero), _mm_unpacklo_epi8(bottom1, zero));
+            __m128i sum3 = _mm_add_epi16(_mm_unpackhi_epi8(top1, zero), _mm_unpackhi_epi8(bottom1, zero));
+
+            // horizontal sums, each register holds two neighbouring pixels in its halves
+            __m128i pair01 = _mm_add_epi16(_mm_unpacklo_epi64(sum0, sum1), _mm_unpackhi_epi64(sum0, sum1));
+            __m128i pair23 = _mm_add_epi16(_mm_unpacklo_epi64(sum2, sum3), _mm_unpackhi_epi64(sum2, sum3));
+
+            pair01 = _mm_srli_epi16(_mm_add_epi16(pair01, two), 2);
+            pair23 = _mm_srli_epi16(_mm_add_epi16(pair23, two), 2);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(pair01, pair23));
+        }
+#endif
+
+        for(; x < width; ++x)
+        {
+            quint32 a = top[2 * x], b = top[2 * x + 1], c = bottom[2 * x], d = bottom[2 * x + 1];
+            quint32 pixel = 0;
+            for(int shift = 0; shift < 32; shift += 8)
+            {
+                quint32 sum = ((a >> shift) & 0xff) + ((b >> shift) & 0xff) + ((c >> shift) & 0xff) + ((d >> shift) & 0xff);
+                pixel |= ((sum + 2) / 4) << shift;
+            }
+            out[x] = pixel;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef FRAMEDOWNSCALER_H
+#define FRAMEDOWNSCALER_H
+
+#include <QImage>
+#include <QSize>
+#include <QVector>
+
+// Shrinks RGB32 frames by halving them with a 2x2 box filter until one more
+// halving would go below the requested size. The halving is SSE2 where the
+// build targets it. Intermediate images are kept and reused while the frame
+// size does not change, so a frame costs no allocation.
+class FrameDownscaler
+{
+public:
+    const QImage& downscale(const QImage& frame, const QSize& minimumSize);
+
+    static void halve(const QImage& source, QImage* target);
+
+private:
+    QVector<QImage> stages;
+};
+
+#endif // FRAMEDOWNSCALER_H
@@ -0,0 +1,152 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "iconatlas.h"
+
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QPainter>
+#include <QStandardPaths>
+#include <QStyle>
+#include <QVector>
+#include <QDebug>
+
+// bump whenever the icon list or the layout changes
+const int ATLAS_VERSION = 1;
+const int ICON_SIZES[] = {16, 32};
+const int CELL_SIZE = 32;
+const int ROW_COUNT = 4; // each size, plain then inverted
+
+struct IconSource
+{
+    QStyle::StandardPixmap standardPixmap;
+    const char *resource;
+};
+
+// in the order of IconAtlas::Icon, a resource path wins over the standard pixmap
+const IconSource ICON_SOURCES[IconAtlas::ICON_COUNT] =
+{
+    {QStyle::SP_MediaPlay, nullptr},
+    {QStyle::SP_MediaPause, nullptr},
+    {QStyle::SP_MediaStop, nullptr},
+    {QStyle::SP_MediaSkipBackward, nullptr},
+    {QStyle::SP_MediaSkipForward, nullptr},
+    {QStyle::SP_MediaSeekForward, nullptr},
+    {QStyle::SP_MediaSeekBackward, nullptr},
+    {QStyle::SP_MediaVolume, nullptr},
+    {QStyle::SP_MediaVolumeMuted, nullptr},
+    {QStyle::SP_CustomBase, ":/images/icons/fullscreen.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/exit-fullscreen.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/picture-in-picture.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/exit-picture-in-picture.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/playlist.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/chapterList.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/nextChapter.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/previousChapter.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/toggleRepeat.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/loop_current.png"},
+    {QStyle::SP_CustomBase, ":/images/icons/random.png"}
+};
+
+static QVector<QIcon> icons;
+
+static QString cachePath()
+{
+    // a rebuilt executable may carry other resources, a restyled one other standard pixmaps
+    QByteArray key = QByteArray(QT_VERSION_STR) + '\0' + QByteArray::number(ATLAS_VERSION) + '\0' +
+            QApplication::style()->objectName().toUtf8() + '\0' +
+            QByteArray::number(QFileInfo(QCoreApplication::applicationFilePath()).lastModified().toMSecsSinceEpoch());
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/icons/atlas-" +
+            QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex().left(16) + ".png";
+}
+
+static QImage renderAtlas()
+{
+    QImage atlas(CELL_SIZE * IconAtlas::ICON_COUNT, CELL_SIZE * ROW_COUNT, QImage::Format_ARGB32);
+    atlas.fill(Qt::transparent);
+
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for(int id = 0; id < IconAtlas::ICON_COUNT; ++id)
+    {
+        const IconSource& source = ICON_SOURCES[id];
+        QIcon icon = source.resource ? QIcon(source.resource) : QApplication::style()->standardIcon(source.standardPixmap);
+
+        int row = 0;
+        for(int size : ICON_SIZES)
+        {
+            QImage image = icon.pixmap(size).toImage().convertToFormat(QImage::Format_ARGB32);
+            image.setDevicePixelRatio(1);
+            // icons without this size come back smaller, centered in the cell
+            QPoint offset((size - image.width()) / 2, (size - image.height()) / 2);
+            painter.drawImage(QPoint(id * CELL_SIZE, row++ * CELL_SIZE) + offset, image);
+            image.invertPixels();
+            painter.drawImage(QPoint(id * CELL_SIZE, row++ * CELL_SIZE) + offset, image);
+        }
+    }
+
+    return atlas;
+}
+
+QIcon IconAtlas::icon(Icon id, Variant variant)
+{
+    if(icons.isEmpty())
+        load();
+
+    return icons.at(id * 2 + variant);
+}
+
+void IconAtlas::load()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QString path = cachePath();
+    QImage atlas(path);
+    bool cached = ! atlas.isNull();
+    if(! cached)
+    {
+        atlas = renderAtlas();
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        if(! atlas.save(path, "PNG"))
+            qWarning() << "Icon atlas: cannot write" << path;
+    }
+
+    QPixmap pixmap = QPixmap::fromImage(atlas);
+    icons.resize(ICON_COUNT * 2);
+    for(int id = 0; id < ICON_COUNT; ++id)
+    {
+        for(int variant : {NORMAL, INVERTED})
+        {
+            QIcon& icon = icons[id * 2 + variant];
+            int row = variant;
+            for(int size : ICON_SIZES)
+            {
+                icon.addPixmap(pixmap.copy(id * CELL_SIZE, row * CELL_SIZE, size, size));
+                row += 2;
+            }
+        }
+    }
+
+    qInfo() << "Icon atlas:" << (cached ? "loaded" : "rendered") << "in" << timer.elapsed() << "ms";
+}
@@ -0,0 +1,69 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <QIcon>
+
+// Every icon of the player controls and menus, plain and color inverted,
+// rendered once into a single image. The image is kept in the cache
+// directory keyed on the executable and the style, so later starts decode one
+// file instead of loading each icon and inverting its pixels. The icons are
+// cut from the atlas on first use and shared from then on.
+class IconAtlas
+{
+public:
+    enum Icon
+    {
+        PLAY,
+        PAUSE,
+        STOP,
+        PREVIOUS,
+        NEXT,
+        SEEK_FORWARD,
+        SEEK_BACKWARD,
+        VOLUME,
+        VOLUME_MUTED,
+        FULLSCREEN,
+        EXIT_FULLSCREEN,
+        PIC_IN_PIC,
+        EXIT_PIC_IN_PIC,
+        PLAYLIST,
+        CHAPTER_LIST,
+        NEXT_CHAPTER,
+        PREVIOUS_CHAPTER,
+        TOGGLE_REPEAT,
+        LOOP_CURRENT,
+        RANDOM,
+        ICON_COUNT
+    };
+
+    enum Variant
+    {
+        NORMAL,
+        INVERTED
+    };
+
+    static QIcon icon(Icon id, Variant variant = NORMAL);
+
+private:
+    static void load();
+};
+
+#endif // ICONATLAS_H
@@ -0,0 +1,328 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "keyframeindex.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#include "shared.h"
+
+const quint32 CACHE_MAGIC = 0x514b4631; // "QKF1"
+const qint64 MAX_MOOV_SIZE = 64 * 1024 * 1024;
+
+KeyframeIndex::KeyframeIndex(const QVector<qint64> &timestamps)
+    : keyframes(timestamps)
+{
+}
+
+bool KeyframeIndex::isEmpty() const
+{
+    return keyframes.isEmpty();
+}
+
+int KeyframeIndex::size() const
+{
+    return keyframes.size();
+}
+
+qint64 KeyframeIndex::keyframeAtOrBefore(qint64 time) const
+{
+    if(keyframes.isEmpty())
+        return time;
+
+    auto it = std::upper_bound(keyframes.cbegin(), keyframes.cend(), time);
+    if(it == keyframes.cbegin())
+        return keyframes.first();
+
+    return *(it - 1);
+}
+
+const QVector<qint64> &KeyframeIndex::timestamps() const
+{
+    return keyframes;
+}
+
+bool KeyframeIndex::isScannable(const QString &filePath)
+{
+    static const QStringList isoBmffSuffixes = {"mp4", "m4v", "mov", "3gp", "3g2", "3gpp", "3gp2", "f4v"};
+    return isoBmffSuffixes.contains(QFileInfo(filePath).suffix(), Qt::CaseInsensitive);
+}
+
+/* ---- ISO base media file format (mp4/mov) ------------------------------------ */
+
+namespace {
+
+struct Box
+{
+    const uchar *payload;
+    qint64 size;
+};
+
+// Finds the first child box of the given type inside [data, data + size).
+bool findBox(const uchar *data, qint64 size, const char *type, Box *box)
+{
+    qint64 offset = 0;
+    while(offset + 8 <= size)
+    {
+        qint64 boxSize = qFromBigEndian<quint32>(data + offset);
+        qint64 header = 8;
+        if(boxSize == 1)
+        {
+            if(offset + 16 > size)
+                return false;
+            boxSize = qFromBigEndian<quint64>(data + offset + 8);
+            header = 16;
+        }
+        else if(boxSize == 0)
+        {
+            boxSize = size - offset;
+        }
+
+        if(boxSize < header || offset + boxSize > size)
+            return false;
+
+        if(memcmp(data + offset + 4, type, 4) == 0)
+        {
+            box->payload = data + offset + header;
+            box->size = boxSize - header;
+            return true;
+        }
+        offset += boxSize;
+    }
+    return false;
+}
+
+bool findPath(const uchar *data, qint64 size, const QList<const char*>& path, Box *box)
+{
+    Box current = {data, size};
+    for(const char *type : path)
+    {
+        if(! findBox(current.payload, current.size, type, &current))
+            return false;
+    }
+    *box = current;
+    return true;
+}
+
+// Reads the moov box, skipping over mdat wherever it is in the file.
+QByteArray readMoov(QFile &file, QString *error)
+{
+    qint64 offset = 0;
+    const qint64 fileSize = file.size();
+    while(offset + 8 <= fileSize)
+    {
+        if(! file.seek(offset))
+            break;
+
+        uchar header[16];
+        if(file.read(reinterpret_cast<char*>(header), 8) != 8)
+            break;
+
+        qint64 boxSize = qFromBigEndian<quint32>(header);
+        qint64 headerSize = 8;
+        if(boxSize == 1)
+        {
+            if(file.read(reinterpret_cast<char*>(header + 8), 8) != 8)
+                break;
+            boxSize = qFromBigEndian<quint64>(header + 8);
+            headerSize = 16;
+        }
+        else if(boxSize == 0)
+        {
+            boxSize = fileSize - offset;
+        }
+
+        if(boxSize < headerSize)
+            break;
+
+        if(memcmp(header + 4, "moov", 4) == 0)
+        {
+            if(boxSize > MAX_MOOV_SIZE)
+            {
+                if(error)
+                    *error = "moov box too large";
+                return QByteArray();
+            }
+            return file.read(boxSize - headerSize);
+        }
+        offset += boxSize;
+    }
+
+    if(error)
+        *error = "no moov box";
+    return QByteArray();
+}
+
+}
+
+KeyframeIndex KeyframeIndex::scanMp4(const QString &filePath, QString *error)
+{
+    QFile file(filePath);
+    if(! file.open(QIODevice::ReadOnly))
+    {
+        if(error)
+            *error = file.errorString();
+        return KeyframeIndex();
+    }
+
+    const QByteArray moov = readMoov(file, error);
+    const uchar *data = reinterpret_cast<const uchar*>(moov.constData());
+    const qint64 size = moov.size();
+
+    // walk the tracks until the first video one
+    qint64 offset = 0;
+    while(offset < size)
+    {
+        Box trak;
+        if(! findBox(data + offset, size - offset, "trak", &trak))
+            break;
+        offset = (trak.payload - data) + trak.size;
+
+        Box hdlr, mdhd, stts, stss;
+        if(! findPath(trak.payload, trak.size, {"mdia", "hdlr"}, &hdlr) || hdlr.size < 12 ||
+                memcmp(hdlr.payload + 8, "vide", 4) != 0)
+            continue;
+
+        if(! findPath(trak.payload, trak.size, {"mdia", "mdhd"}, &mdhd) ||
+                ! findPath(trak.payload, trak.size, {"mdia", "minf", "stbl", "stts"}, &stts))
+        {
+            if(error)
+                *error = "incomplete video track";
+            return KeyframeIndex();
+        }
+
+        // without stss every sample is a sync sample, snapping would be pointless
+        if(! findPath(trak.payload, trak.size, {"mdia", "minf", "stbl", "stss"}, &stss))
+            return KeyframeIndex();
+
+        const int version = mdhd.payload[0];
+        const qint64 timescaleOffset = (version == 1) ? 20 : 12;
+        if(mdhd.size < timescaleOffset + 4 || stts.size < 8 || stss.size < 8)
+            break;
+
+        const quint32 timescale = qFromBigEndian<quint32>(mdhd.payload + timescaleOffset);
+        const quint32 sttsCount = qFromBigEndian<quint32>(stts.payload + 4);
+        const quint32 stssCount = qFromBigEndian<quint32>(stss.payload + 4);
+        if(timescale == 0 || stts.size < 8 + qint64(sttsCount) * 8 || stss.size < 8 + qint64(stssCount) * 4)
+            break;
+
+        QVector<qint64> timestamps;
+        timestamps.reserve(stssCount);
+
+        // stss lists 1-based sample numbers in increasing order, stts run-length encodes sample durations
+        quint32 sttsEntry = 0;
+        quint64 entryFirstSample = 1;
+        quint64 entryStartTime = 0;
+        for(quint32 i = 0; i < stssCount; ++i)
+        {
+            const quint64 sample = qFromBigEndian<quint32>(stss.payload + 8 + i * 4);
+
+            while(sttsEntry < sttsCount)
+            {
+                const quint32 count = qFromBigEndian<quint32>(stts.payload + 8 + sttsEntry * 8);
+                const quint32 delta = qFromBigEndian<quint32>(stts.payload + 12 + sttsEntry * 8);
+                if(sample < entryFirstSample + count)
+                    break;
+
+                entryFirstSample += count;
+                entryStartTime += quint64(count) * delta;
+                ++sttsEntry;
+            }
+            if(sttsEntry == sttsCount)
+                break;
+
+            const quint32 delta = qFromBigEndian<quint32>(stts.payload + 12 + sttsEntry * 8);
+            const quint64 time = entryStartTime + (sample - entryFirstSample) * delta;
+            timestamps.append(qint64(time * 1000 / timescale));
+        }
+
+        return KeyframeIndex(timestamps);
+    }
+
+    if(error && error->isEmpty())
+        *error = "no video track";
+    return KeyframeIndex();
+}
+
+/* ---- disk cache ------------------------------------------------------------------ */
+
+QString KeyframeIndex::cachePath(const QString &filePath)
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/keyframes/" +
+            fileFingerprint(filePath) + ".idx";
+}
+
+bool KeyframeIndex::loadFromCache(const QString &filePath, KeyframeIndex *index)
+{
+    QFile file(cachePath(filePath));
+    if(! file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0, count = 0;
+    stream >> magic >> count;
+    if(magic != CACHE_MAGIC || count > file.size() / 4)
+        return false;
+
+    // stored as deltas between keyframes, which always fit in 32 bits
+    QVector<qint64> timestamps(count);
+    qint64 time = 0;
+    for(quint32 i = 0; i < count; ++i)
+    {
+        quint32 delta = 0;
+        stream >> delta;
+        time += delta;
+        timestamps[i] = time;
+    }
+
+    if(stream.status() != QDataStream::Ok)
+        return false;
+
+    *index = KeyframeIndex(timestamps);
+    return true;
+}
+
+bool KeyframeIndex::saveToCache(const QString &filePath) const
+{
+    QString path = cachePath(filePath);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if(! file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << quint32(keyframes.size());
+
+    qint64 previous = 0;
+    for(qint64 time : keyframes)
+    {
+        stream << quint32(qMax<qint64>(0, time - previous));
+        previous = time;
+    }
+
+    return file.commit();
+}
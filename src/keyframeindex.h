@@ -0,0 +1,49 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef KEYFRAMEINDEX_H
+#define KEYFRAMEINDEX_H
+
+#include <QString>
+#include <QVector>
+
+// Sorted presentation times (ms) of the keyframes of a file's video track.
+// An empty index means it is unknown, or that every frame is a keyframe.
+class KeyframeIndex
+{
+public:
+    KeyframeIndex() {}
+    explicit KeyframeIndex(const QVector<qint64>& timestamps);
+
+    bool isEmpty() const;
+    int size() const;
+    qint64 keyframeAtOrBefore(qint64 time) const;
+    const QVector<qint64>& timestamps() const;
+
+    static KeyframeIndex scanMp4(const QString& filePath, QString* error = nullptr);
+    static bool isScannable(const QString& filePath);
+
+    static QString cachePath(const QString& filePath);
+    static bool loadFromCache(const QString& filePath, KeyframeIndex* index);
+    bool saveToCache(const QString& filePath) const;
+
+private:
+    QVector<qint64> keyframes;
+};
+
+#endif // KEYFRAMEINDEX_H
@@ -23,8 +23,20 @@
 #include <QSettings>
 #include <QList>
 #include <QUrl>
+#include <QTimer>
+#include <QStandardPaths>
+#include <QDir>
 
 #include "shared.h"
+#include "benchmarks.h"
+#include "mediaformats.h"
+#include "startuptrace.h"
+#include "singleinstance.h"
+#include "stallwatchdog.h"
+#include "tracer.h"
+#include "vlcloader.h"
+#include "performanceprofile.h"
+#include "settings.h"
 
 void associateFileExtensions()
 {
@@ -32,7 +44,7 @@ void associateFileExtensions()
     QString exePath = qApp->applicationFilePath();
     exePath.replace("/", "\\");
 
-    for(auto const& e : supportedMediaFormats)
+    for(auto const& e : MediaFormats::extensions(MediaFormats::PLAYABLE))
     {
         QSettings regType("HKEY_CURRENT_USER\\SOFTWARE\\Classes\\." + e,
                           QSettings::NativeFormat);
@@ -63,7 +75,11 @@ void associateFileExtensions()
 
 int main(int argc, char *argv[])
 {
+    StartupTrace::start(argc, argv);
+    Tracer::start(argc, argv);
+
     QApplication a(argc, argv);
+    StartupTrace::mark("application created");
 
     // associateFileExtensions();
 
@@ -72,6 +88,24 @@ int main(int argc, char *argv[])
     QCoreApplication::setApplicationName("QThisPlayer");
     QSettings::setDefaultFormat(QSettings::IniFormat);
 
+    if(Benchmarks::run(a.arguments()))
+        return 0;
+
+    // hand the files to the running player and leave before libvlc is loaded
+    SingleInstance singleInstance;
+    bool useSingleInstance = Settings.singleInstance() && ! SingleInstance::isNewInstanceRequested(a.arguments());
+    if(useSingleInstance && singleInstance.forwardOrListen(a.arguments()))
+        return 0;
+
+    QString pluginPath = qApp->applicationDirPath() + "/lib/vlc";
+    if(qEnvironmentVariableIsEmpty("VLC_PLUGIN_PATH"))
+    {
+        qputenv("VLC_PLUGIN_PATH", pluginPath.toLocal8Bit());
+    }
+
+    // plugins load while the window is built and shown
+    VlcLoader vlcLoader(PerformanceProfile::instanceArguments(PerformanceProfile::fromInt(Settings.performanceProfile())));
+
     QPalette darkPalette;
     QColor darkColor = QColor(27,27,27);
     QColor disabledColor = QColor(127,127,127);
@@ -93,10 +127,24 @@ int main(int argc, char *argv[])
     darkPalette.setColor(QPalette::HighlightedText, Qt::black);
     darkPalette.setColor(QPalette::Disabled, QPalette::HighlightedText, disabledColor);
 
+    StallWatchdog stallWatchdog(Settings.stallThreshold());
+
     qApp->setStyle(QStyleFactory::create("fusion"));
     qApp->setPalette(darkPalette);
 
     MainWindow w;
+    StartupTrace::mark("main window constructed");
+    QObject::connect(&singleInstance, &SingleInstance::filesReceived, &w, &MainWindow::openReceivedFiles);
     w.show();
-    return a.exec();
+    StartupTrace::mark("main window shown");
+
+    QTimer::singleShot(0, &StartupTrace::eventLoopStarted);
+    int exitCode = a.exec();
+
+    QString logDir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(logDir);
+    stallWatchdog.writeLog(logDir + "/stalls.log");
+    Tracer::finish();
+
+    return exitCode;
 }
@@ -22,6 +22,7 @@
 #include <windows.h>
 #endif
 #include <QAction>
+#include <QActionGroup>
 #include <QMenuBar>
 #include <QApplication>
 #include <QMouseEvent>
@@ -29,31 +30,53 @@
 #include <QStackedWidget>
 #include <QToolButton>
 #include <QFileDialog>
+#include <QMessageBox>
 #include <QUrl>
+#include <QDebug>
+#include <QDir>
+#include <QWindow>
 
 #include "components/videoWidget.h"
 #include "components/playercontroller.h"
 #include "settings.h"
+#include "iconatlas.h"
 #include "dialogs/about.h"
+#include "singleinstance.h"
+#include "mediaformats.h"
+#include "stallwatchdog.h"
+#include "tracer.h"
+
+// seconds, the report timer itself adds one wakeup per period
+const int WAKEUP_COUNT_PERIOD = 60;
+
+// both picture-in-picture paths should have the video on screen within a frame of the switch
+static void logPicInPicSwitch(double elapsed, double frameInterval)
+{
+    qInfo() << "Picture-in-picture: first frame after" << elapsed << "ms, frame interval" << frameInterval << "ms";
+    if(frameInterval > 0 && elapsed > frameInterval)
+        qWarning() << "Picture-in-picture: switch took longer than a frame";
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
-    QString path = qApp->applicationDirPath() + "/lib/vlc";
-    if (qEnvironmentVariableIsEmpty("VLC_PLUGIN_PATH"))
-    {
-        qputenv("VLC_PLUGIN_PATH", path.toLocal8Bit());
-    }
-
 #ifdef  Q_OS_LINUX
     this->setWindowIcon(QIcon(QPixmap(":/images/icons/app_icon.png")));
 #endif
 
     mainPage = new MainPage;
+    gotoTime = nullptr;
+    picInPicWin = nullptr;
+    picInPicFrameView = nullptr;
+    chapterDockWidget = nullptr;
+
+    statsOverlay = new StatsOverlay();
+    statsOverlay->setViewWidget(mainPage);
 
     //  tests();
 
     createMenuAndActions();
+    startDiagnostics();
 
     this->setCentralWidget(mainPage);
     this->setMouseTracking(true);
@@ -65,6 +88,7 @@ MainWindow::MainWindow(QWidget *parent)
     shouldSaveSettings = false;
 
     timerMouse = new QTimer(this);
+    timerMouse->setSingleShot(true);
     connect(timerMouse, &QTimer::timeout, this, &MainWindow::hideMouse);
 
     connect(mainPage, &MainPage::mouseMove, this, &MainWindow::showMouse);
@@ -73,7 +97,8 @@ MainWindow::MainWindow(QWidget *parent)
     {
         QString title = filename.isEmpty() ? qAppName() : (filename + " - " + qAppName());
         this->setWindowTitle(title);
-        picInPicWin->setWinTitle(title);
+        if(picInPicWin)
+            picInPicWin->setWinTitle(title);
     });
 
     connect(mainPage, &MainPage::togglePicInPicWindow, this, [this]
@@ -91,37 +116,129 @@ MainWindow::MainWindow(QWidget *parent)
     });
     connect(mainPage, &MainPage::toggleChapterListView, this, [this]
     {
-        showChapterlist(!chapterDockWidget->isVisible());
+        showChapterlist(! (chapterDockWidget && chapterDockWidget->isVisible()));
     });
     connect(mainPage, &MainPage::message, this, [this] (QString message, bool isError)
     {
         screenMessage->displayMessage(message, (isError) ? ScreenMessage::ShowOption::ERROR_ : ScreenMessage::ShowOption::GENERAL);
     });
-    connect(&gotoTime, &GoToTime::goToTime, mainPage, &MainPage::setPlayerTime);
 
     screenMessage = new ScreenMessage();
     screenMessage->setViewWidget(mainPage);
     connect(screenMessage, &ScreenMessage::mouseWheelRolledUp, mainPage, &MainPage::increaseVolume);
     connect(screenMessage, &ScreenMessage::mouseWheelRolledDown, mainPage, &MainPage::decreaseVolume);
 
-    picInPicWin = new PictureInPictureWindow();
-    connect(picInPicWin, &PictureInPictureWindow::exitPicInPic, this, &MainWindow::setPicInPicWindow);
-    connect(mainPage, &MainPage::mouseMove, picInPicWin, &PictureInPictureWindow::showMouse);
-
     playlistDockWidget = new QDockWidget("Playlist",this);
     playlistDockWidget->setFeatures(QDockWidget::NoDockWidgetFeatures);
     playlistDockWidget->setWidget(mainPage->playlistPage());
     playlistDockWidget->setMinimumWidth(160);
     playlistDockWidget->hide();
 
-    chapterDockWidget = new QDockWidget(tr("Chapter List"),this);
-    chapterDockWidget->setFeatures(QDockWidget::NoDockWidgetFeatures);
-    chapterDockWidget->setWidget(mainPage->chpaterPage());
-    playlistDockWidget->setMinimumWidth(160);
-    chapterDockWidget->hide();
-
-    addDockWidget(Qt::LeftDockWidgetArea, chapterDockWidget);
     addDockWidget(Qt::RightDockWidgetArea, playlistDockWidget);
+
+    // libvlc may still be loading, the window does not wait for it
+    if(mainPage->isPlayerReady())
+        onPlayerReady();
+    else
+        connect(mainPage, &MainPage::playerReady, this, &MainWindow::onPlayerReady);
+}
+
+void MainWindow::onPlayerReady()
+{
+    if(isInPicInPicWindow && mainPage->rendersThroughFramePool())
+        showPicInPicFrameView();
+    statsOverlay->setSampler(mainPage->statsSampler());
+    connect(mainPage->decodeQualityGovernor(), &DecodeQualityGovernor::levelChanged, this, [this] (DecodeQualityGovernor::Level level)
+    {
+        screenMessage->displayMessage(tr("Decode quality: ") + DecodeQualityGovernor::levelName(level), ScreenMessage::ShowOption::GENERAL);
+    });
+}
+
+// The picture-in-picture window, the chapter dock and the go to time dialog
+// are only built the first time they are needed, they are not part of startup.
+PictureInPictureWindow *MainWindow::pictureInPictureWindow()
+{
+    if(! picInPicWin)
+    {
+        picInPicWin = new PictureInPictureWindow();
+        picInPicWin->setWinTitle(this->windowTitle());
+        connect(picInPicWin, &PictureInPictureWindow::exitPicInPic, this, &MainWindow::setPicInPicWindow);
+        connect(mainPage, &MainPage::mouseMove, picInPicWin, &PictureInPictureWindow::showMouse);
+
+        // without the frame pool the switch is over once the moved surface is exposed
+        if(VideoSurface* surface = mainPage->videoWidget()->surface())
+        {
+            connect(surface, &VideoSurface::firstExpose, this, [this] (double elapsed)
+            {
+                VlcMediaPlayer* player = mainPage->player();
+                float fps = player ? player->frameRate() : 0;
+                logPicInPicSwitch(elapsed, fps > 0 ? 1000 / fps : 0);
+            });
+        }
+    }
+    return picInPicWin;
+}
+
+// With the frame pool the window gets its own view of the frames. The view is
+// built when picture-in-picture is shown with the pool ready, or by
+// onPlayerReady() when it was shown before libvlc was loaded.
+void MainWindow::showPicInPicFrameView()
+{
+    FramePool* pool = mainPage->framePool();
+    if(! pool)
+        return;
+
+    if(! picInPicFrameView)
+    {
+        picInPicFrameView = new FrameView(pool, picInPicWin);
+        picInPicWin->setCentralWidget(picInPicFrameView);
+        updatePicInPicFrameRate();
+        connect(mainPage->decodeQualityGovernor(), &DecodeQualityGovernor::pipFrameRateCapChanged, this, &MainWindow::updatePicInPicFrameRate);
+        connect(picInPicFrameView, &FrameView::mouseMove, picInPicWin, &PictureInPictureWindow::showMouse);
+        mainPage->watchVideoView(picInPicFrameView);
+        connect(picInPicFrameView, &FrameView::firstFramePainted, this, [pool] (double elapsed)
+        {
+            logPicInPicSwitch(elapsed, pool->frameInterval());
+        });
+    }
+    picInPicFrameView->startMeasuring();
+}
+
+void MainWindow::updatePicInPicFrameRate()
+{
+    if(! picInPicFrameView)
+        return;
+
+    // the lower of the user's cap and the one the decode governor asks for under load, 0 is no cap
+    int userCap = Settings.picInPicFrameRate();
+    int governorCap = mainPage->decodeQualityGovernor()->pipFrameRateCap();
+    int cap = (userCap > 0 && governorCap > 0) ? qMin(userCap, governorCap) : qMax(userCap, governorCap);
+    picInPicFrameView->setMaxFrameRate(cap);
+}
+
+QDockWidget *MainWindow::chapterDock()
+{
+    if(! chapterDockWidget)
+    {
+        chapterDockWidget = new QDockWidget(tr("Chapter List"),this);
+        chapterDockWidget->setFeatures(QDockWidget::NoDockWidgetFeatures);
+        chapterDockWidget->setWidget(mainPage->chpaterPage());
+        chapterDockWidget->setMinimumWidth(160);
+        chapterDockWidget->hide();
+
+        addDockWidget(Qt::LeftDockWidgetArea, chapterDockWidget);
+    }
+    return chapterDockWidget;
+}
+
+void MainWindow::showGoToTime()
+{
+    if(! gotoTime)
+    {
+        gotoTime = new GoToTime(this);
+        connect(gotoTime, &GoToTime::goToTime, mainPage, &MainPage::setPlayerTime);
+    }
+    gotoTime->exec();
 }
 
 void MainWindow::settingStyleSheet()
@@ -137,24 +254,10 @@ void MainWindow::openFiles(QString caption, bool play)
 {
     QFileDialog dialog(this, caption);
     dialog.setFileMode(QFileDialog::ExistingFiles);
-    dialog.setNameFilter(tr("Media Files(*.3g2 *.3gp *.3gp2 *.3gpp *.amv *.asf *.avi *.bik *.bin *.divx *.drc *.dv "
-                            "*.f4v *.flv *.gvi *.gxf *.iso *.m1v *.m2v *.m2t *.m2ts *.m4v *.mkv *.mov *.mp2 *.mp2V "
-                            "*.mp4 *.mp4v *.mpe *.mpeg *.mpeg1 *.mpeg2 *.mpeg4 *.mpg *.mpv2 *.mts *.mtv *.mxf *.mxg "
-                            "*.nsv *.nuv *.ogg *.ogm *.ogv *.ogx *.ps *.rec *.rm *.rmvb *.rpl *.thp *.tod *.ts *.tts "
-                            "*.txd *.vob *.vro *.webm *.wm *.wmv *.wtv *.xesc *.3ga *.669 *.152 *.aac *.ac3 *.adt "
-                            "*.adts *.aif *.aiff *.amr *.aob *.ape *.awb *.caf *.dts *.flac *.it *.kar *.m4a *.m4b "
-                            "*.m4p *.m5p *.mid *.mka *.mlp *.mod *.mpa *.mp1 *.mp2 *.mp3 *.mpc *.mpga *.mus *.oga "
-                            "*.ogg *oma *.opus *.qcp *.ra *.rmi *.s3m *.sid *.spx *.thd *.tta *.voc *vqf *.w64 *.wav "
-                            "*.wma *.wv *.xa *.xm);;Video Files(*.3g2 *.3gp *.3gp2 *.3gpp *.amv *.asf *.avi *.bik "
-                            "*.bin *.divx *.drc *.dv *.f4v *.flv *.gvi *.gxf *.iso *.m1v *.m2v *.m2t *.m2ts *.m4v "
-                            "*.mkv *.mov *.mp2 *.mp2V *.mp4 *.mp4v *.mpe *.mpeg *.mpeg1 *.mpeg2 *.mpeg4 *.mpg *.mpv2 "
-                            "*.mts *.mtv *.mxf *.mxg *.nsv *.nuv *.ogg *.ogm *.ogv *.ogx *.ps *.rec *.rm *.rmvb *.rpl "
-                            "*.thp *.tod *.ts *.tts *.txd *.vob *.vro *.webm *.wm *.wmv *.wtv *.xesc);;"
-                            "Audio Files(*.3ga *.669 *.152 *.aac *.ac3 *.adt *.adts *.aif *.aiff *.amr *.aob *.ape "
-                            "*.awb *.caf *.dts *.flac *.it *.kar *.m4a *.m4b *.m4p *.m5p *.mid *.mka *.mlp *.mod *.mpa "
-                            "*.mp1 *.mp2 *.mp3 *.mpc *.mpga *.mus *.oga *.ogg *oma *.opus *.qcp *.ra *.rmi *.s3m *.sid "
-                            "*.spx *.thd *.tta *.voc *vqf *.w64 *.wav *.wma *.wv *.xa *.xm);;"
-                            "All Files(*)"));
+    dialog.setNameFilter(MediaFormats::nameFilter(tr("Media Files"), MediaFormats::PLAYABLE) + ";;" +
+                         MediaFormats::nameFilter(tr("Video Files"), MediaFormats::VIDEO) + ";;" +
+                         MediaFormats::nameFilter(tr("Audio Files"), MediaFormats::AUDIO) + ";;" +
+                         tr("All Files(*)"));
     dialog.setViewMode(QFileDialog::Detail);
     dialog.setAcceptMode(QFileDialog::AcceptOpen);
     dialog.setDirectory(Settings.lastOpenFoler());
@@ -177,9 +280,8 @@ void MainWindow::addSubtitlesFile()
     {
         QFileDialog dialog(this, tr("Open subtitle file"));
         dialog.setFileMode(QFileDialog::ExistingFiles);
-        dialog.setNameFilter(tr("Subtitle Files(*.cdg *.idx *.srt *.sub *.utf *.ass *.ssa *.aqt *.jss *.psb *.rt *.sami "
-                                "*.smi *.txt *.smil *.stl *.usf *.dks *.pjs *.mpl2 *.mks *.vtt *.tt *.ttml *.dfxp *.scc);;"
-                                "All Files(*)"));
+        dialog.setNameFilter(MediaFormats::nameFilter(tr("Subtitle Files"), MediaFormats::SUBTITLE) + ";;" +
+                             tr("All Files(*)"));
         dialog.setViewMode(QFileDialog::Detail);
         dialog.setAcceptMode(QFileDialog::AcceptOpen);
         dialog.setDirectory(Settings.lastOpenFoler());
@@ -198,7 +300,7 @@ void MainWindow::addChapterFile()
     {
         QFileDialog dialog(this, tr("Open chapters file"));
         dialog.setFileMode(QFileDialog::ExistingFile);
-        dialog.setNameFilter(tr("Chapters File(*.txt *.ch)"));
+        dialog.setNameFilter(MediaFormats::nameFilter(tr("Chapters File"), MediaFormats::CHAPTER));
         dialog.setViewMode(QFileDialog::Detail);
         dialog.setAcceptMode(QFileDialog::AcceptOpen);
         dialog.setDirectory(Settings.lastOpenFoler());
@@ -213,17 +315,56 @@ void MainWindow::addChapterFile()
 
 void MainWindow::openFilesFromExplorer()
 {
-    QList<QUrl> files;
-    for(int i = 1; i < qApp->arguments().size(); ++i)
+    QList<QUrl> files = SingleInstance::filesFromArguments(qApp->arguments());
+    if(! files.isEmpty())
     {
-        files << QUrl::fromLocalFile(qApp->arguments().at(i));
+        mainPage->openFiles(files, ! SingleInstance::isEnqueueRequested(qApp->arguments()));
     }
+}
+
+void MainWindow::openReceivedFiles(const QList<QUrl> &files, bool play)
+{
     if(! files.isEmpty())
+        mainPage->openFiles(files, play);
+
+    if(play)
     {
-        mainPage->openFiles(files, true/*play*/);
+        QWidget* window = isInPicInPicWindow ? static_cast<QWidget*>(picInPicWin) : this;
+        if(window->isMinimized())
+            window->showNormal();
+        window->raise();
+        window->activateWindow();
     }
 }
 
+void MainWindow::exportPlaybackStats()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export playback statistics"),
+                                                    Settings.lastOpenFoler() + "/playback-stats.csv",
+                                                    tr("CSV Files(*.csv)"));
+    if(filePath.isEmpty() || ! mainPage->statsSampler())
+        return;
+
+    if(mainPage->statsSampler()->exportToCsv(filePath))
+        screenMessage->displayMessage(tr("Playback statistics exported"), ScreenMessage::ShowOption::GENERAL);
+    else
+        screenMessage->displayMessage(tr("Could not write ") + filePath, ScreenMessage::ShowOption::ERROR_);
+}
+
+void MainWindow::exportTrace()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export trace"),
+                                                    Settings.lastOpenFoler() + "/qthisplayer-trace.json",
+                                                    tr("Trace Files(*.json)"));
+    if(filePath.isEmpty())
+        return;
+
+    if(Tracer::exportJson(filePath))
+        screenMessage->displayMessage(tr("Trace exported (%1 events)").arg(Tracer::eventCount()), ScreenMessage::ShowOption::GENERAL);
+    else
+        screenMessage->displayMessage(tr("Could not write ") + filePath, ScreenMessage::ShowOption::ERROR_);
+}
+
 void MainWindow::showPlaylist(bool show)
 {
     isPlaylistShown = show;
@@ -237,8 +378,8 @@ void MainWindow::showChapterlist(bool show)
 {
     isChapterListShown = show;
     if(show)
-        chapterDockWidget->show();
-    else
+        chapterDock()->show();
+    else if(chapterDockWidget)
         chapterDockWidget->hide();
 }
 
@@ -290,26 +431,42 @@ void MainWindow::setPicInPicWindow(bool picInPic, bool exitByClosing)
     isInPicInPicWindow = picInPic;
     if(picInPic)
     {
+        pictureInPictureWindow();
         screenMessage->setViewWidget(picInPicWin);
+        statsOverlay->setViewWidget(picInPicWin);
         this->hide();
         mainPage->playerController()->hide();
         mainPage->playerController()->setPicInPicView(true);
-        picInPicWin->setCentralWidget(mainPage);
+        // without the frame pool only the native surface libvlc renders into moves, its handle stays the same
+        if(mainPage->rendersThroughFramePool())
+            showPicInPicFrameView();
+        else
+        {
+            // an audio-only or stopped player has no video to wait for
+            if(mainPage->videoWidget()->hasVideoOutput())
+                mainPage->videoWidget()->surface()->startMeasuring();
+            picInPicWin->setCentralWidget(mainPage->videoWidget()->takeSurface());
+        }
         picInPicWin->takeController(mainPage->playerController());
         picInPicWin->show();
     }
     else
     {
         screenMessage->setViewWidget(mainPage);
-        picInPicWin->takeCentralWidget();
+        statsOverlay->setViewWidget(mainPage);
+        if(! mainPage->rendersThroughFramePool())
+        {
+            picInPicWin->takeCentralWidget();
+            mainPage->videoWidget()->restoreSurface();
+        }
         picInPicWin->hide();
         mainPage->playerController()->setPicInPicView(false);
-        this->setCentralWidget(mainPage);
         onNormalScreen();
         restoreWindow();
         if(exitByClosing)
         {
-            if(mainPage->player()->state() == Vlc::Playing || mainPage->player()->state() == Vlc::Opening)
+            VlcMediaPlayer* player = mainPage->player();
+            if(player && (player->state() == Vlc::Playing || player->state() == Vlc::Opening))
                 mainPage->playerController()->clickPlayButton();
 
             this->showMinimized();
@@ -317,6 +474,16 @@ void MainWindow::setPicInPicWindow(bool picInPic, bool exitByClosing)
         else
             this->show();
     }
+
+    updateVideoVisibility();
+}
+
+void MainWindow::updateVideoVisibility()
+{
+    // hidden, minimized or, where the platform reports it, completely covered by other windows
+    bool mainWindowVisible = this->isVisible() && ! this->isMinimized() && this->windowHandle() && this->windowHandle()->isExposed();
+    bool picInPicVisible = isInPicInPicWindow && picInPicWin && picInPicWin->isVisible();
+    mainPage->setVideoVisible(mainWindowVisible || picInPicVisible);
 }
 
 void MainWindow::toggleFullScreen()
@@ -369,8 +536,12 @@ void MainWindow::showMouse()
     this->setCursor(Qt::ArrowCursor);
     if(this->isFullScreen())
     {
-        mainPage->playerController()->setWindowFlags(Qt::WindowStaysOnTopHint);
-        mainPage->playerController()->show();
+        // every mouse move lands here, recreating the controller window each time is not free
+        if(! mainPage->playerController()->isVisible() || ! mainPage->playerController()->isWindow())
+        {
+            mainPage->playerController()->setWindowFlags(Qt::WindowStaysOnTopHint);
+            mainPage->playerController()->show();
+        }
         timerMouse->start(1000);
     }
 }
@@ -410,6 +581,14 @@ void MainWindow::createMenuAndActions()
         Settings.setQuitAtTheEndOfPlaylist(checked);
     });
 
+    QAction* singleInstanceAction = new QAction(tr("Open files in the running player"), this);
+    singleInstanceAction->setCheckable(true);
+    singleInstanceAction->setChecked(Settings.singleInstance());
+    connect(singleInstanceAction, &QAction::toggled, this, [] (bool checked)
+    {
+        Settings.setSingleInstance(checked);
+    });
+
     QAction* quitAction = new QAction(tr("Quit"), this);
     quitAction->setShortcut(QKeySequence::Quit);
     connect(quitAction, &QAction::triggered, this, &QMainWindow::close);
@@ -418,6 +597,7 @@ void MainWindow::createMenuAndActions()
     mediaMenu->addAction(addFilesToPlaylistAction);
     mediaMenu->addSeparator();
     mediaMenu->addAction(quitAtEndOfPlaylistAction);
+    mediaMenu->addAction(singleInstanceAction);
     mediaMenu->addAction(quitAction);
 
     //add actions for video menu
@@ -426,47 +606,44 @@ void MainWindow::createMenuAndActions()
 
     //Actions for the playBack menu
     QAction* seekForwardAction = new QAction(tr("Seek Forward"), this);
-    seekForwardAction->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaSeekForward)));
+    seekForwardAction->setIcon(IconAtlas::icon(IconAtlas::SEEK_FORWARD, IconAtlas::INVERTED));
     connect(seekForwardAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickSeekForwardButton);
 
     QAction* seekBackwardAction = new QAction(tr("Seek Backward"), this);
-    seekBackwardAction->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaSeekBackward)));
+    seekBackwardAction->setIcon(IconAtlas::icon(IconAtlas::SEEK_BACKWARD, IconAtlas::INVERTED));
     connect(seekBackwardAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickSeekBackwardButton);
 
     QAction* seekToSpecificTimeAction = new QAction(tr("Jump to Specific Time"), this);
     seekToSpecificTimeAction->setShortcut(QKeySequence(Qt::CTRL|Qt::Key_T));
-    connect(seekToSpecificTimeAction, &QAction::triggered, this, [this]
-    {
-        gotoTime.exec();
-    });
+    connect(seekToSpecificTimeAction, &QAction::triggered, this, &MainWindow::showGoToTime);
 
     QAction* playAction = new QAction(tr("Play"), this);
-    playAction->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaPlay)));
+    playAction->setIcon(IconAtlas::icon(IconAtlas::PLAY, IconAtlas::INVERTED));
     connect(playAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickPlayButton);
     connect(mainPage, &MainPage::mediaStateChanged, this, [this, playAction] (Vlc::State state)
     {
         if(state == Vlc::Opening || state == Vlc::Playing)
         {
             playAction->setText(tr("Pause"));
-            playAction->setIcon(style()->standardIcon(QStyle::SP_MediaPlay));
+            playAction->setIcon(IconAtlas::icon(IconAtlas::PLAY));
         }
         if(state == Vlc::Paused || state == Vlc::Stopped || state == Vlc::Ended)
         {
             playAction->setText(tr("Play"));
-            playAction->setIcon(style()->standardIcon(QStyle::SP_MediaPause));
+            playAction->setIcon(IconAtlas::icon(IconAtlas::PAUSE));
         }
     });
 
     QAction* stopAction = new QAction(tr("Stop"), this);
-    stopAction->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaStop)));
+    stopAction->setIcon(IconAtlas::icon(IconAtlas::STOP, IconAtlas::INVERTED));
     connect(stopAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickStopButton);
 
     QAction* previousAction = new QAction(tr("Previous"), this);
-    previousAction->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaSkipBackward)));
+    previousAction->setIcon(IconAtlas::icon(IconAtlas::PREVIOUS, IconAtlas::INVERTED));
     connect(previousAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickPreviousButton);
 
     QAction* nextAction = new QAction(tr("Next"), this);
-    nextAction->setIcon(invertedColorIcon(style()->standardIcon(QStyle::SP_MediaSkipForward)));
+    nextAction->setIcon(IconAtlas::icon(IconAtlas::NEXT, IconAtlas::INVERTED));
     connect(nextAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickNextButton);
 
 //    recordAction = new QAction(tr("Record"), this);
@@ -482,6 +659,64 @@ void MainWindow::createMenuAndActions()
     playbackMenu->addAction(stopAction);
     playbackMenu->addAction(previousAction);
     playbackMenu->addAction(nextAction);
+    playbackMenu->addSeparator();
+
+    QAction* snapToKeyframesAction = new QAction(tr("Snap to Keyframes While Scrubbing"), this);
+    snapToKeyframesAction->setCheckable(true);
+    snapToKeyframesAction->setChecked(Settings.snapToKeyframes());
+    connect(snapToKeyframesAction, &QAction::toggled, this, [this] (bool checked)
+    {
+        Settings.setSnapToKeyframes(checked);
+        mainPage->playerController()->mediaProgressSlider()->setSnapToKeyframes(checked);
+    });
+    playbackMenu->addAction(snapToKeyframesAction);
+
+    QAction* backgroundAudioAction = new QAction(tr("Audio Only While Hidden"), this);
+    backgroundAudioAction->setCheckable(true);
+    backgroundAudioAction->setChecked(Settings.backgroundAudioOnly());
+    connect(backgroundAudioAction, &QAction::toggled, this, [this] (bool checked)
+    {
+        Settings.setBackgroundAudioOnly(checked);
+        if(mainPage->backgroundAudioMode())
+            mainPage->backgroundAudioMode()->setEnabled(checked);
+    });
+    playbackMenu->addAction(backgroundAudioAction);
+
+    QAction* fastStartAction = new QAction(tr("Fast Start"), this);
+    fastStartAction->setCheckable(true);
+    fastStartAction->setChecked(mainPage->isFastStart());
+    connect(fastStartAction, &QAction::toggled, mainPage, &MainPage::setFastStart);
+    playbackMenu->addAction(fastStartAction);
+
+    // rarely used, so its actions are only created the first time it is opened
+    auto performanceProfileMenu = playbackMenu->addMenu(tr("Performance Profile"));
+    connect(performanceProfileMenu, &QMenu::aboutToShow, this, [this, performanceProfileMenu]
+    {
+        if(! performanceProfileMenu->isEmpty())
+            return;
+
+        auto performanceProfileGroup = new QActionGroup(performanceProfileMenu);
+        for(int i = 0; i < PerformanceProfile::PROFILE_COUNT; ++i)
+        {
+            auto profile = static_cast<PerformanceProfile::Profile>(i);
+            QAction* profileAction = new QAction(PerformanceProfile::name(profile), performanceProfileGroup);
+            profileAction->setCheckable(true);
+            profileAction->setChecked(profile == mainPage->performanceProfile());
+            connect(profileAction, &QAction::triggered, this, [this, profile]
+            {
+                mainPage->setPerformanceProfile(profile);
+            });
+            performanceProfileMenu->addAction(profileAction);
+        }
+        performanceProfileMenu->addSeparator();
+
+        QAction* showEffectiveOptionsAction = new QAction(tr("Show Effective Options..."), performanceProfileMenu);
+        connect(showEffectiveOptionsAction, &QAction::triggered, this, [this]
+        {
+            QMessageBox::information(this, tr("Performance Profile"), mainPage->effectivePerformanceOptions());
+        });
+        performanceProfileMenu->addAction(showEffectiveOptionsAction);
+    });
 
 
     //Actions for the audio menu
@@ -563,10 +798,106 @@ void MainWindow::createMenuAndActions()
     QAction* takeSnapshotAction = new QAction(tr("Take Snapshot"));
     connect(takeSnapshotAction, &QAction::triggered, mainPage, &MainPage::takeSnapshot);
 
+    QAction* takeSnapshotBurstAction = new QAction(tr("Take Snapshot Burst"));
+    connect(takeSnapshotBurstAction, &QAction::triggered, mainPage, &MainPage::takeSnapshotBurst);
+
+    QAction* copySnapshotsAction = new QAction(tr("Copy Snapshots to Clipboard"));
+    copySnapshotsAction->setCheckable(true);
+    copySnapshotsAction->setChecked(Settings.copySnapshotsToClipboard());
+    connect(copySnapshotsAction, &QAction::triggered, this, [this] (bool checked)
+    {
+        if(mainPage->snapshotPipeline())
+            mainPage->snapshotPipeline()->setCopyToClipboard(checked);
+        Settings.setCopySnapshotsToClipboard(checked);
+    });
+
     videoMenu->addAction(fullScreenAction);
     videoMenu->addAction(picInPicAction);
     videoMenu->addSeparator();
     videoMenu->addAction(takeSnapshotAction);
+    videoMenu->addAction(takeSnapshotBurstAction);
+    videoMenu->addAction(copySnapshotsAction);
+
+    QAction* framePoolAction = new QAction(tr("Render Through Frame Pool"));
+    framePoolAction->setCheckable(true);
+    framePoolAction->setChecked(Settings.renderThroughFramePool());
+    connect(framePoolAction, &QAction::triggered, this, [this] (bool checked)
+    {
+        Settings.setRenderThroughFramePool(checked);
+        screenMessage->displayMessage(tr("Render path changes after restart"), ScreenMessage::ShowOption::GENERAL);
+    });
+
+    auto snapshotFormatMenu = videoMenu->addMenu(tr("Snapshot Format"));
+    connect(snapshotFormatMenu, &QMenu::aboutToShow, this, [this, snapshotFormatMenu]
+    {
+        if(! snapshotFormatMenu->isEmpty())
+            return;
+
+        auto snapshotFormatGroup = new QActionGroup(snapshotFormatMenu);
+        for(const QString& format : SnapshotPipeline::supportedFormats())
+        {
+            QAction* formatAction = new QAction(format.toUpper(), snapshotFormatGroup);
+            formatAction->setCheckable(true);
+            formatAction->setChecked(format == Settings.snapshotFormat());
+            connect(formatAction, &QAction::triggered, this, [this, format]
+            {
+                if(mainPage->snapshotPipeline())
+                    mainPage->snapshotPipeline()->setFormat(format);
+                Settings.setSnapshotFormat(format);
+            });
+            snapshotFormatMenu->addAction(formatAction);
+        }
+    });
+
+    auto snapshotFolderMenu = videoMenu->addMenu(tr("Snapshot Folder"));
+    auto snapshotFolderGroup = new QActionGroup(snapshotFolderMenu);
+    QAction* nextToMediaAction = new QAction(tr("Next to the Media"), snapshotFolderGroup);
+    nextToMediaAction->setCheckable(true);
+    QAction* chooseFolderAction = new QAction(tr("Choose Folder..."), snapshotFolderGroup);
+    chooseFolderAction->setCheckable(true);
+    snapshotFolderMenu->addAction(nextToMediaAction);
+    snapshotFolderMenu->addAction(chooseFolderAction);
+    connect(snapshotFolderMenu, &QMenu::aboutToShow, this, [nextToMediaAction, chooseFolderAction]
+    {
+        QString folder = Settings.snapshotFolder();
+        nextToMediaAction->setChecked(folder.isEmpty());
+        chooseFolderAction->setChecked(! folder.isEmpty());
+        chooseFolderAction->setText(folder.isEmpty() ? tr("Choose Folder...") : QDir::toNativeSeparators(folder));
+    });
+    connect(nextToMediaAction, &QAction::triggered, this, [this]
+    {
+        if(mainPage->snapshotPipeline())
+            mainPage->snapshotPipeline()->setOutputFolder(QString());
+        Settings.setSnapshotFolder(QString());
+    });
+    connect(chooseFolderAction, &QAction::triggered, this, [this]
+    {
+        QString folder = QFileDialog::getExistingDirectory(this, tr("Snapshot Folder"), Settings.snapshotFolder());
+        if(folder.isEmpty())
+            return;
+
+        if(mainPage->snapshotPipeline())
+            mainPage->snapshotPipeline()->setOutputFolder(folder);
+        Settings.setSnapshotFolder(folder);
+    });
+    videoMenu->addSeparator();
+    videoMenu->addAction(framePoolAction);
+
+    auto picInPicFrameRateMenu = videoMenu->addMenu(tr("Picture-in-Picture Frame Rate"));
+    picInPicFrameRateMenu->setEnabled(Settings.renderThroughFramePool());
+    auto picInPicFrameRateGroup = new QActionGroup(picInPicFrameRateMenu);
+    for(int fps : {10, 15, 24, 30, 0})
+    {
+        QAction* frameRateAction = new QAction(fps > 0 ? tr("%1 fps").arg(fps) : tr("Unlimited"), picInPicFrameRateGroup);
+        frameRateAction->setCheckable(true);
+        frameRateAction->setChecked(fps == Settings.picInPicFrameRate());
+        connect(frameRateAction, &QAction::triggered, this, [this, fps]
+        {
+            Settings.setPicInPicFrameRate(fps);
+            updatePicInPicFrameRate();
+        });
+        picInPicFrameRateMenu->addAction(frameRateAction);
+    }
 
     //Actions for the subtitle menu
 
@@ -588,17 +919,71 @@ void MainWindow::createMenuAndActions()
     auto viewMenu = this->menuBar()->addMenu("View");
 
     QAction* togllePlayListAction = new QAction(tr("PlayList"), this);
-    togllePlayListAction->setIcon(invertedColorIcon(QIcon(":/images/icons/playlist.png")));
+    togllePlayListAction->setIcon(IconAtlas::icon(IconAtlas::PLAYLIST, IconAtlas::INVERTED));
     togllePlayListAction->setShortcut(QKeySequence(Qt::CTRL|Qt::Key_L));
     connect(togllePlayListAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickPlaylistButton);
 
     QAction* toggleChapterListAction = new QAction(tr("Chapter List"), this);
-    toggleChapterListAction->setIcon(invertedColorIcon(QIcon(":/images/icons/chapterList.png")));
+    toggleChapterListAction->setIcon(IconAtlas::icon(IconAtlas::CHAPTER_LIST, IconAtlas::INVERTED));
     toggleChapterListAction->setShortcut(QKeySequence(Qt::CTRL|Qt::Key_C));
     connect(toggleChapterListAction, &QAction::triggered, mainPage->playerController(), &PlayerController::clickChapterListButton);
 
+    QAction* togglePlaybackStatsAction = new QAction(tr("Playback Statistics"), this);
+    togglePlaybackStatsAction->setShortcut(QKeySequence(Qt::CTRL|Qt::Key_I));
+    connect(togglePlaybackStatsAction, &QAction::triggered, statsOverlay, &StatsOverlay::toggle);
+
+    QAction* exportPlaybackStatsAction = new QAction(tr("Export Playback Statistics..."), this);
+    connect(exportPlaybackStatsAction, &QAction::triggered, this, &MainWindow::exportPlaybackStats);
+
+    QAction* showFirstFrameTimesAction = new QAction(tr("Time to First Frame..."), this);
+    connect(showFirstFrameTimesAction, &QAction::triggered, this, [this]
+    {
+        FirstFrameTimer* timer = mainPage->firstFrameTimer();
+        QMessageBox::information(this, tr("Time to First Frame"), timer ? timer->report() : tr("libvlc is still loading"));
+    });
+
+    QAction* showStallsAction = new QAction(tr("GUI Stalls..."), this);
+    connect(showStallsAction, &QAction::triggered, this, [this]
+    {
+        StallWatchdog* watchdog = StallWatchdog::instance();
+        QMessageBox::information(this, tr("GUI Stalls"), watchdog ? watchdog->report() : tr("The stall watchdog is not running"));
+    });
+
+    QAction* recordTraceAction = new QAction(tr("Record Trace"), this);
+    recordTraceAction->setCheckable(true);
+    recordTraceAction->setChecked(Tracer::isEnabled());
+    connect(recordTraceAction, &QAction::toggled, this, [] (bool record) { Tracer::setEnabled(record); });
+
+    QAction* exportTraceAction = new QAction(tr("Export Trace..."), this);
+    connect(exportTraceAction, &QAction::triggered, this, &MainWindow::exportTrace);
+
     viewMenu->addAction(togllePlayListAction);
     viewMenu->addAction(toggleChapterListAction);
+    viewMenu->addSeparator();
+    viewMenu->addAction(togglePlaybackStatsAction);
+    viewMenu->addAction(exportPlaybackStatsAction);
+    viewMenu->addAction(showFirstFrameTimesAction);
+    viewMenu->addAction(showStallsAction);
+
+    auto stallThresholdMenu = viewMenu->addMenu(tr("GUI Stall Threshold"));
+    auto stallThresholdGroup = new QActionGroup(stallThresholdMenu);
+    for(int msec : {16, 50, 200})
+    {
+        QAction* thresholdAction = new QAction(tr("%1 ms").arg(msec), stallThresholdGroup);
+        thresholdAction->setCheckable(true);
+        thresholdAction->setChecked(msec == Settings.stallThreshold());
+        connect(thresholdAction, &QAction::triggered, this, [msec]
+        {
+            Settings.setStallThreshold(msec);
+            if(StallWatchdog::instance())
+                StallWatchdog::instance()->setThreshold(msec);
+        });
+        stallThresholdMenu->addAction(thresholdAction);
+    }
+
+    viewMenu->addSeparator();
+    viewMenu->addAction(recordTraceAction);
+    viewMenu->addAction(exportTraceAction);
 
 
     //Action for the help menu
@@ -630,6 +1015,7 @@ void MainWindow::resizeEvent(QResizeEvent *event)
     }
     event->accept();
     screenMessage->adjustPositionToParent();
+    statsOverlay->adjustPositionToParent();
 }
 
 void MainWindow::moveEvent(QMoveEvent *event)
@@ -640,6 +1026,7 @@ void MainWindow::moveEvent(QMoveEvent *event)
     }
     event->accept();
     screenMessage->adjustPositionToParent();
+    statsOverlay->adjustPositionToParent();
 }
 
 void MainWindow::showEvent(QShowEvent* event)
@@ -655,9 +1042,36 @@ void MainWindow::showEvent(QShowEvent* event)
     }
     shouldSaveSettings = true;
 
+    // expose events go to the native window, not to the widget
+    this->windowHandle()->removeEventFilter(this);
+    this->windowHandle()->installEventFilter(this);
+    updateVideoVisibility();
+
     event->accept();
 }
 
+void MainWindow::hideEvent(QHideEvent *event)
+{
+    updateVideoVisibility();
+    QMainWindow::hideEvent(event);
+}
+
+void MainWindow::changeEvent(QEvent *event)
+{
+    if(event->type() == QEvent::WindowStateChange)
+        updateVideoVisibility();
+
+    QMainWindow::changeEvent(event);
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if(watched == this->windowHandle() && event->type() == QEvent::Expose)
+        updateVideoVisibility();
+
+    return QMainWindow::eventFilter(watched, event);
+}
+
 //void MainWindow::changeEvent(QEvent *e)
 //{
 //    if( e->type() == QEvent::WindowStateChange )
@@ -677,6 +1091,40 @@ void MainWindow::showEvent(QShowEvent* event)
 //    QWidget::changeEvent(e);
 //}
 
+// switches for release builds too, the TEST menu is only built by hand
+void MainWindow::startDiagnostics()
+{
+    const QStringList arguments = qApp->arguments();
+    for(const QString& argument : arguments)
+    {
+        // --count-wakeups[=seconds]: reports the GUI thread timer wakeups every period,
+        // pause, stop or minimize the player meanwhile to check the idle mode
+        if(argument == "--count-wakeups" || argument.startsWith("--count-wakeups="))
+        {
+            int seconds = argument.section('=', 1).toInt();
+            if(seconds <= 0)
+                seconds = WAKEUP_COUNT_PERIOD;
+
+            auto counter = new WakeupCounter(this);
+            counter->start();
+            auto timer = new QTimer(this);
+            connect(timer, &QTimer::timeout, this, [this, counter]
+            {
+                counter->stop();
+                qInfo().noquote() << "Wakeups while" << (mainPage->isIdle() ? "idle:" : "active:") << counter->report();
+                counter->start();
+            });
+            timer->start(seconds * 1000);
+        }
+        // --simulate-cpu-load[=threads]: keeps the cores busy so the decode governor steps down
+        else if(argument == "--simulate-cpu-load" || argument.startsWith("--simulate-cpu-load="))
+        {
+            cpuLoadSimulator.start(argument.section('=', 1).toInt());
+            qInfo() << "CPU load simulator: running, the decode governor should step down";
+        }
+    }
+}
+
 void MainWindow::tests()
 {
     auto open = new QAction("Open");
@@ -26,8 +26,12 @@
 
 #include "components/mainpage.h"
 #include "components/pictureinpicturewindow.h"
+#include "components/frameview.h"
 #include "components/screenmessage.h"
+#include "components/statsoverlay.h"
 #include "dialogs/gototime.h"
+#include "cpuloadsimulator.h"
+#include "wakeupcounter.h"
 
 class MainWindow : public QMainWindow
 {
@@ -37,6 +41,9 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow() {};
 
+public slots:
+    void openReceivedFiles(const QList<QUrl>& files, bool play);
+
 private:
     void settingStyleSheet();
     void showPlaylist(bool show);
@@ -55,14 +62,27 @@ private:
     void addSubtitlesFile();
     void addChapterFile();
     void openFilesFromExplorer();
+    void exportPlaybackStats();
+    void exportTrace();
+    void showGoToTime();
+    void updatePicInPicFrameRate();
+    void updateVideoVisibility();
+    void onPlayerReady();
+    void showPicInPicFrameView();
+    void startDiagnostics();
+    PictureInPictureWindow* pictureInPictureWindow();
+    QDockWidget* chapterDock();
 
-    GoToTime gotoTime;
+    GoToTime* gotoTime;
     PictureInPictureWindow* picInPicWin;
+    FrameView* picInPicFrameView;
     MainPage* mainPage;
     QDockWidget* playlistDockWidget;
     QDockWidget* chapterDockWidget;
     ScreenMessage *screenMessage;
+    StatsOverlay *statsOverlay;
     QTimer* timerMouse;
+    CpuLoadSimulator cpuLoadSimulator;
 
     bool isPlaylistShown;
     bool isChapterListShown;
@@ -76,7 +96,9 @@ private:
     void resizeEvent(QResizeEvent*) override;
     void moveEvent(QMoveEvent*) override;
     void showEvent(QShowEvent*) override;
-//    void changeEvent(QEvent*) override;
+    void hideEvent(QHideEvent*) override;
+    void changeEvent(QEvent*) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 };
 
 #endif // MAINWINDOW_H
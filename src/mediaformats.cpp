@@ -0,0 +1,277 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "mediaformats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+struct MediaExtension
+{
+    const char *extension;
+    int kinds;
+};
+
+const int MAX_EXTENSION_LENGTH = 8;
+
+enum
+{
+    VIDEO = MediaFormats::VIDEO,
+    AUDIO = MediaFormats::AUDIO,
+    SUBTITLE = MediaFormats::SUBTITLE,
+    CHAPTER = MediaFormats::CHAPTER,
+    PLAYLIST = MediaFormats::PLAYLIST
+};
+
+// Must stay sorted (plain byte order, lower case) and free of duplicates,
+// the static_assert below refuses to build otherwise.
+constexpr MediaExtension MEDIA_EXTENSIONS[] =
+{
+    {"3g2", VIDEO},
+    {"3ga", AUDIO},
+    {"3gp", VIDEO},
+    {"3gp2", VIDEO},
+    {"3gpp", VIDEO},
+    {"669", AUDIO},
+    {"a52", AUDIO},
+    {"aac", AUDIO},
+    {"ac3", AUDIO},
+    {"adt", AUDIO},
+    {"adts", AUDIO},
+    {"aif", AUDIO},
+    {"aiff", AUDIO},
+    {"amr", AUDIO},
+    {"amv", VIDEO},
+    {"aob", AUDIO},
+    {"ape", AUDIO},
+    {"aqt", SUBTITLE},
+    {"asf", VIDEO},
+    {"ass", SUBTITLE},
+    {"asx", PLAYLIST},
+    {"avi", VIDEO},
+    {"awb", AUDIO},
+    {"bik", VIDEO},
+    {"bin", VIDEO},
+    {"caf", AUDIO},
+    {"cdg", SUBTITLE},
+    {"ch", CHAPTER},
+    {"cue", PLAYLIST},
+    {"dfxp", SUBTITLE},
+    {"divx", VIDEO},
+    {"dks", SUBTITLE},
+    {"drc", VIDEO},
+    {"dts", AUDIO},
+    {"dv", VIDEO},
+    {"f4v", VIDEO},
+    {"flac", AUDIO},
+    {"flv", VIDEO},
+    {"gvi", VIDEO},
+    {"gxf", VIDEO},
+    {"idx", SUBTITLE},
+    {"iso", VIDEO},
+    {"it", AUDIO},
+    {"jss", SUBTITLE},
+    {"kar", AUDIO},
+    {"m1v", VIDEO},
+    {"m2t", VIDEO},
+    {"m2ts", VIDEO},
+    {"m2v", VIDEO},
+    {"m3u", PLAYLIST},
+    {"m3u8", PLAYLIST},
+    {"m4a", AUDIO},
+    {"m4b", AUDIO},
+    {"m4p", AUDIO},
+    {"m4v", VIDEO},
+    {"m5p", AUDIO},
+    {"mid", AUDIO},
+    {"mka", AUDIO},
+    {"mks", SUBTITLE},
+    {"mkv", VIDEO},
+    {"mlp", AUDIO},
+    {"mod", AUDIO},
+    {"mov", VIDEO},
+    {"mp1", AUDIO},
+    {"mp2", VIDEO | AUDIO},
+    {"mp2v", VIDEO},
+    {"mp3", AUDIO},
+    {"mp4", VIDEO},
+    {"mp4v", VIDEO},
+    {"mpa", AUDIO},
+    {"mpc", AUDIO},
+    {"mpe", VIDEO},
+    {"mpeg", VIDEO},
+    {"mpeg1", VIDEO},
+    {"mpeg2", VIDEO},
+    {"mpeg4", VIDEO},
+    {"mpg", VIDEO},
+    {"mpga", AUDIO},
+    {"mpl2", SUBTITLE},
+    {"mpv2", VIDEO},
+    {"mts", VIDEO},
+    {"mtv", VIDEO},
+    {"mus", AUDIO},
+    {"mxf", VIDEO},
+    {"mxg", VIDEO},
+    {"nsv", VIDEO},
+    {"nuv", VIDEO},
+    {"oga", AUDIO},
+    {"ogg", VIDEO | AUDIO},
+    {"ogm", VIDEO},
+    {"ogv", VIDEO},
+    {"ogx", VIDEO},
+    {"oma", AUDIO},
+    {"opus", AUDIO},
+    {"pjs", SUBTITLE},
+    {"pls", PLAYLIST},
+    {"ps", VIDEO},
+    {"psb", SUBTITLE},
+    {"qcp", AUDIO},
+    {"ra", AUDIO},
+    {"rec", VIDEO},
+    {"rm", VIDEO},
+    {"rmi", AUDIO},
+    {"rmvb", VIDEO},
+    {"rpl", VIDEO},
+    {"rt", SUBTITLE},
+    {"s3m", AUDIO},
+    {"sami", SUBTITLE},
+    {"scc", SUBTITLE},
+    {"sid", AUDIO},
+    {"smi", SUBTITLE},
+    {"smil", SUBTITLE},
+    {"spx", AUDIO},
+    {"srt", SUBTITLE},
+    {"ssa", SUBTITLE},
+    {"stl", SUBTITLE},
+    {"sub", SUBTITLE},
+    {"thd", AUDIO},
+    {"thp", VIDEO},
+    {"tod", VIDEO},
+    {"ts", VIDEO},
+    {"tt", SUBTITLE},
+    {"tta", AUDIO},
+    {"ttml", SUBTITLE},
+    {"tts", VIDEO},
+    {"txd", VIDEO},
+    {"txt", SUBTITLE | CHAPTER},
+    {"usf", SUBTITLE},
+    {"utf", SUBTITLE},
+    {"vob", VIDEO},
+    {"voc", AUDIO},
+    {"vqf", AUDIO},
+    {"vro", VIDEO},
+    {"vtt", SUBTITLE},
+    {"w64", AUDIO},
+    {"wav", AUDIO},
+    {"webm", VIDEO},
+    {"wm", VIDEO},
+    {"wma", AUDIO},
+    {"wmv", VIDEO},
+    {"wpl", PLAYLIST},
+    {"wtv", VIDEO},
+    {"wv", AUDIO},
+    {"xa", AUDIO},
+    {"xesc", VIDEO},
+    {"xm", AUDIO},
+    {"xspf", PLAYLIST}
+};
+
+constexpr std::size_t MEDIA_EXTENSION_COUNT = sizeof(MEDIA_EXTENSIONS) / sizeof(MEDIA_EXTENSIONS[0]);
+
+constexpr bool isLess(const char *a, const char *b)
+{
+    return (*a == *b) ? (*a != '\0' && isLess(a + 1, b + 1))
+                      : (static_cast<unsigned char>(*a) < static_cast<unsigned char>(*b));
+}
+
+constexpr bool isSorted(const MediaExtension *table, std::size_t count)
+{
+    return count < 2 || (isLess(table[0].extension, table[1].extension) && isSorted(table + 1, count - 1));
+}
+
+static_assert(isSorted(MEDIA_EXTENSIONS, MEDIA_EXTENSION_COUNT), "MEDIA_EXTENSIONS must be sorted and without duplicates");
+
+int MediaFormats::lookup(const QChar *extension, int length)
+{
+    if(length <= 0 || length > MAX_EXTENSION_LENGTH)
+        return NONE;
+
+    char key[MAX_EXTENSION_LENGTH + 1];
+    for(int i = 0; i < length; ++i)
+    {
+        ushort c = extension[i].unicode();
+        if(c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        else if(c > 0x7f)
+            return NONE;
+
+        key[i] = static_cast<char>(c);
+    }
+    key[length] = '\0';
+
+    auto first = std::begin(MEDIA_EXTENSIONS);
+    auto last = std::end(MEDIA_EXTENSIONS);
+    auto it = std::lower_bound(first, last, key, [] (const MediaExtension& entry, const char* value)
+    {
+        return std::strcmp(entry.extension, value) < 0;
+    });
+
+    return (it != last && std::strcmp(it->extension, key) == 0) ? it->kinds : NONE;
+}
+
+int MediaFormats::kindsOfExtension(const QString &extension)
+{
+    return lookup(extension.constData(), extension.size());
+}
+
+int MediaFormats::kindsOfPath(const QString &path)
+{
+    // the suffix is whatever follows the last dot of the file name, same as QFileInfo::suffix()
+    const QChar* data = path.constData();
+    for(int i = path.size() - 1; i >= 0; --i)
+    {
+        if(data[i] == QLatin1Char('.'))
+            return lookup(data + i + 1, path.size() - i - 1);
+
+        if(data[i] == QLatin1Char('/') || data[i] == QLatin1Char('\\'))
+            break;
+    }
+    return NONE;
+}
+
+bool MediaFormats::isOfKind(const QString &path, int kinds)
+{
+    return (kindsOfPath(path) & kinds) != 0;
+}
+
+QStringList MediaFormats::extensions(int kinds)
+{
+    QStringList list;
+    for(const MediaExtension& entry : MEDIA_EXTENSIONS)
+    {
+        if(entry.kinds & kinds)
+            list << QString::fromLatin1(entry.extension);
+    }
+    return list;
+}
+
+QString MediaFormats::nameFilter(const QString &name, int kinds)
+{
+    return name + "(*." + extensions(kinds).join(" *.") + ")";
+}
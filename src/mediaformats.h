@@ -0,0 +1,51 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef MEDIAFORMATS_H
+#define MEDIAFORMATS_H
+
+#include <QString>
+#include <QStringList>
+
+// Classifies file extensions against one sorted, compile-time checked table.
+// Lookups are a binary search over string literals and do not allocate.
+class MediaFormats
+{
+public:
+    enum Kind
+    {
+        NONE     = 0x00,
+        VIDEO    = 0x01,
+        AUDIO    = 0x02,
+        SUBTITLE = 0x04,
+        CHAPTER  = 0x08,
+        PLAYLIST = 0x10,
+        PLAYABLE = VIDEO | AUDIO
+    };
+
+    static int kindsOfExtension(const QString& extension);
+    static int kindsOfPath(const QString& path);
+    static bool isOfKind(const QString& path, int kinds);
+    static QStringList extensions(int kinds);
+    static QString nameFilter(const QString& name, int kinds);
+
+private:
+    static int lookup(const QChar* extension, int length);
+};
+
+#endif // MEDIAFORMATS_H
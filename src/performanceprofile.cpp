@@ -0,0 +1,96 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "performanceprofile.h"
+
+#include <QObject>
+
+PerformanceProfile::Profile PerformanceProfile::fromInt(int value)
+{
+    if(value < 0 || value >= PROFILE_COUNT)
+        return MAX_QUALITY;
+
+    return static_cast<Profile>(value);
+}
+
+QString PerformanceProfile::name(Profile profile)
+{
+    switch (profile)
+    {
+    case LOW_LATENCY_LOCAL:
+        return QObject::tr("Low Latency (Local Files)");
+    case SLOW_NETWORK_MOUNT:
+        return QObject::tr("Slow Network Mount");
+    case LOW_POWER_LAPTOP:
+        return QObject::tr("Low Power Laptop");
+    case MAX_QUALITY:
+    default:
+        return QObject::tr("Maximum Quality");
+    }
+}
+
+QStringList PerformanceProfile::instanceArguments(Profile profile)
+{
+    switch (profile)
+    {
+    case LOW_LATENCY_LOCAL:
+        // small read-ahead, no scripting plugins to load, decoder threads picked by libvlc
+        return {"--file-caching=100", "--avcodec-threads=0", "--no-lua"};
+    case SLOW_NETWORK_MOUNT:
+        // a share that stalls for seconds needs a deep buffer and a tolerant clock
+        return {"--file-caching=3000", "--network-caching=3000", "--clock-jitter=10000", "--avcodec-threads=0"};
+    case LOW_POWER_LAPTOP:
+        // let the GPU decode when it can and keep the CPU side cheap
+        return {"--avcodec-hw=any", "--avcodec-threads=2", "--avcodec-skiploopfilter=4", "--no-lua"};
+    case MAX_QUALITY:
+    default:
+        return {"--avcodec-threads=0", "--avcodec-skiploopfilter=0"};
+    }
+}
+
+QStringList PerformanceProfile::mediaOptions(Profile profile)
+{
+    switch (profile)
+    {
+    case LOW_LATENCY_LOCAL:
+        return {":file-caching=100", ":avcodec-fast"};
+    case SLOW_NETWORK_MOUNT:
+        return {":file-caching=3000", ":network-caching=3000"};
+    case LOW_POWER_LAPTOP:
+        return {":avcodec-hw=any", ":avcodec-skiploopfilter=4"};
+    case MAX_QUALITY:
+    default:
+        return {":file-caching=1000", ":avcodec-skip-frame=0", ":avcodec-skiploopfilter=0"};
+    }
+}
+
+// appended after the profile's media options, so they win where both set the same option
+QStringList PerformanceProfile::fastStartOptions(Profile profile)
+{
+    // no art or metadata lookups, no scan of the folder for subtitle files
+    // (MainPage looks for a matching one after the first frame) and a short
+    // probe for the demuxers that go through libavformat
+    QStringList options = {":no-metadata-network-access", ":no-sub-autodetect-file",
+                           ":avformat-options={probesize=500000,analyzeduration=500000}"};
+
+    // a mount that needs the deep buffer would just stall right after starting
+    if(profile != SLOW_NETWORK_MOUNT)
+        options << ":file-caching=150";
+
+    return options;
+}
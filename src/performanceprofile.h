@@ -0,0 +1,46 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef PERFORMANCEPROFILE_H
+#define PERFORMANCEPROFILE_H
+
+#include <QString>
+#include <QStringList>
+
+// Named libvlc tunings. The instance arguments are only read when the
+// VlcInstance is created, the media options are applied to every file opened.
+class PerformanceProfile
+{
+public:
+    enum Profile
+    {
+        LOW_LATENCY_LOCAL,
+        SLOW_NETWORK_MOUNT,
+        LOW_POWER_LAPTOP,
+        MAX_QUALITY,
+        PROFILE_COUNT
+    };
+
+    static Profile fromInt(int value);
+    static QString name(Profile profile);
+    static QStringList instanceArguments(Profile profile);
+    static QStringList mediaOptions(Profile profile);
+    static QStringList fastStartOptions(Profile profile);
+};
+
+#endif // PERFORMANCEPROFILE_H
@@ -0,0 +1,162 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "plugincache.h"
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QTimer>
+#include <QDebug>
+
+#include "settings.h"
+#include "startuptrace.h"
+
+const char CACHE_FILE[] = "plugins.dat";
+const int GENERATOR_TIMEOUT = 120000;
+
+PluginCache::PluginCache(QObject *parent)
+    : QObject(parent)
+{
+    connect(&process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            [this] (int exitCode, QProcess::ExitStatus exitStatus)
+    {
+        bool success = exitStatus == QProcess::NormalExit && exitCode == 0 && check(regeneratedPath) == FRESH;
+        if(success)
+            qInfo() << "Plugin cache: regenerated in" << regeneratedPath;
+        else
+            qWarning() << "Plugin cache: vlc-cache-gen failed:" << process.readAllStandardError().trimmed();
+
+        emit regenerated(success);
+    });
+    connect(&process, &QProcess::errorOccurred, this, [this] (QProcess::ProcessError error)
+    {
+        if(error == QProcess::FailedToStart)
+        {
+            qWarning() << "Plugin cache: cannot run" << process.program();
+            emit regenerated(false);
+        }
+    });
+}
+
+QString PluginCache::pluginPath()
+{
+    return qEnvironmentVariable("VLC_PLUGIN_PATH");
+}
+
+// stats every plugin in the folder, a few milliseconds, so it runs on the loader thread
+PluginCache::State PluginCache::check(const QString &pluginPath)
+{
+    if(pluginPath.isEmpty() || ! QFileInfo(pluginPath).isDir())
+        return NO_PLUGIN_FOLDER;
+
+    QFileInfo cache(pluginPath + "/" + CACHE_FILE);
+    if(! cache.exists())
+        return MISSING;
+
+    QDateTime cacheTime = cache.lastModified();
+    QDirIterator plugins(pluginPath, {"*_plugin.*"}, QDir::Files, QDirIterator::Subdirectories);
+    while(plugins.hasNext())
+    {
+        plugins.next();
+        if(plugins.fileInfo().lastModified() > cacheTime)
+            return STALE;
+    }
+
+    return FRESH;
+}
+
+QString PluginCache::stateName(State state)
+{
+    switch (state)
+    {
+    case FRESH:
+        return "fresh";
+    case MISSING:
+        return "missing";
+    case STALE:
+        return "stale";
+    case NO_PLUGIN_FOLDER:
+    default:
+        return "no bundled plugin folder";
+    }
+}
+
+// keeps the last start of each kind, so the trace shows what the cache saves
+void PluginCache::recordLoadTime(State state, qint64 msec)
+{
+    if(state == FRESH)
+        Settings.setCachedPluginLoadTime(int(msec));
+    else if(state == MISSING || state == STALE)
+        Settings.setScannedPluginLoadTime(int(msec));
+
+    QString text = QString("plugin cache %1, libvlc loaded in %2 ms").arg(stateName(state)).arg(msec);
+
+    int cached = Settings.cachedPluginLoadTime();
+    int scanned = Settings.scannedPluginLoadTime();
+    if(cached > 0 && scanned > 0)
+        text += QString(" (last start with the cache: %1 ms, with a plugin scan: %2 ms)").arg(cached).arg(scanned);
+
+    qInfo().noquote() << "Plugin cache:" << text;
+    StartupTrace::note(text);
+}
+
+bool PluginCache::regenerate(const QString &pluginPath)
+{
+    if(process.state() != QProcess::NotRunning)
+        return false;
+
+    QString generator = cacheGenerator(pluginPath);
+    if(generator.isEmpty())
+    {
+        qWarning() << "Plugin cache: no vlc-cache-gen shipped with the runtime, plugins are scanned at every start";
+        return false;
+    }
+
+    if(! QFileInfo(pluginPath).isWritable())
+    {
+        qWarning() << "Plugin cache:" << pluginPath << "is not writable";
+        return false;
+    }
+
+    qInfo() << "Plugin cache: regenerating with" << generator;
+    regeneratedPath = pluginPath;
+    process.start(generator, {pluginPath});
+    QTimer::singleShot(GENERATOR_TIMEOUT, &process, &QProcess::kill);
+    return true;
+}
+
+QString PluginCache::cacheGenerator(const QString &pluginPath)
+{
+#ifdef Q_OS_WIN
+    const QString name = "vlc-cache-gen.exe";
+#else
+    const QString name = "vlc-cache-gen";
+#endif
+
+    // next to the player, or next to the plugin folder as in a VLC install
+    for(const QString& dir : {QCoreApplication::applicationDirPath(), QFileInfo(pluginPath).absolutePath()})
+    {
+        QFileInfo generator(dir + "/" + name);
+        if(generator.isExecutable())
+            return generator.absoluteFilePath();
+    }
+
+    return QString();
+}
@@ -0,0 +1,61 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef PLUGINCACHE_H
+#define PLUGINCACHE_H
+
+#include <QObject>
+#include <QProcess>
+
+// libvlc reads plugins.dat from the plugin folder so it does not have to
+// open every plugin at startup. When the cache is missing, or older than the
+// plugins next to it, every start pays for a full scan. The cache is rebuilt
+// in the background with the vlc-cache-gen tool shipped with the runtime, so
+// the next start takes the cached path.
+class PluginCache : public QObject
+{
+    Q_OBJECT
+public:
+    enum State
+    {
+        FRESH,
+        MISSING,
+        STALE,
+        NO_PLUGIN_FOLDER
+    };
+
+    explicit PluginCache(QObject *parent = nullptr);
+
+    static QString pluginPath();
+    static State check(const QString& pluginPath);
+    static QString stateName(State state);
+    static void recordLoadTime(State state, qint64 msec);
+
+    bool regenerate(const QString& pluginPath);
+
+signals:
+    void regenerated(bool success);
+
+private:
+    static QString cacheGenerator(const QString& pluginPath);
+
+    QProcess process;
+    QString regeneratedPath;
+};
+
+#endif // PLUGINCACHE_H
@@ -0,0 +1,80 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <array>
+#include <cstddef>
+
+// Fixed-size history that overwrites its oldest entry once full.
+// All the storage lives inside the object, pushing never allocates.
+template <typename T, std::size_t Capacity>
+class RingBuffer
+{
+public:
+    RingBuffer() : head(0), count(0) {}
+
+    void push(const T& value)
+    {
+        items[head] = value;
+        head = (head + 1) % Capacity;
+
+        if(count < Capacity)
+            ++count;
+    }
+
+    // 0 is the oldest entry, size() - 1 the newest
+    const T& at(std::size_t index) const
+    {
+        return items[(head + Capacity - count + index) % Capacity];
+    }
+
+    const T& last() const
+    {
+        return at(count - 1);
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+private:
+    std::array<T, Capacity> items;
+    std::size_t head;
+    std::size_t count;
+};
+
+#endif // RINGBUFFER_H
@@ -17,6 +17,7 @@
 *****************************************************************************/
 
 #include "settings.h"
+#include "performanceprofile.h"
 
 #include <QStandardPaths>
 #include <QSize>
@@ -33,96 +34,348 @@ QThisPlayerSettings &QThisPlayerSettings::singleton()
     return *instance;
 }
 
+const int FLUSH_DELAY = 1000;
+
+// Owns the QSettings used for writing, lives in the writer thread.
+class SettingsWriter : public QObject
+{
+public:
+    void write(const QHash<QString, QVariant>& values)
+    {
+        if(! store)
+            store.reset(new QSettings);
+
+        for(auto it = values.cbegin(); it != values.cend(); ++it)
+            store->setValue(it.key(), it.value());
+
+        store->sync();
+    }
+
+private:
+    QScopedPointer<QSettings> store;
+};
+
+QThisPlayerSettings::QThisPlayerSettings(QObject *parent)
+    : QObject(parent),
+      writer(new SettingsWriter)
+{
+    QSettings settings;
+    const QStringList keys = settings.allKeys();
+    for(const QString& key : keys)
+        cache.insert(key, settings.value(key));
+
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(FLUSH_DELAY);
+    connect(&flushTimer, &QTimer::timeout, this, &QThisPlayerSettings::flush);
+
+    writer->moveToThread(&writerThread);
+    writerThread.setObjectName("Settings writer");
+    writerThread.start(QThread::LowPriority);
+
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &QThisPlayerSettings::stopWriter);
+}
+
+QThisPlayerSettings::~QThisPlayerSettings()
+{
+    stopWriter();
+    flush();
+}
+
+QVariant QThisPlayerSettings::value(const QString &key, const QVariant &defaultValue) const
+{
+    return cache.value(key, defaultValue);
+}
+
+void QThisPlayerSettings::setValue(const QString &key, const QVariant &value)
+{
+    auto it = cache.find(key);
+    if(it != cache.end() && it.value() == value)
+        return;
+
+    cache.insert(key, value);
+    pending.insert(key, value);
+    flushTimer.start();
+
+    emit changed(key, value);
+}
+
+void QThisPlayerSettings::flush()
+{
+    flushTimer.stop();
+    if(pending.isEmpty())
+        return;
+
+    QHash<QString, QVariant> batch;
+    batch.swap(pending);
+
+    if(writer && writerThread.isRunning())
+    {
+        SettingsWriter* target = writer;
+        QMetaObject::invokeMethod(writer, [target, batch] { target->write(batch); });
+    }
+    else
+    {
+        // changes made while shutting down, after the writer thread is gone
+        SettingsWriter lateWriter;
+        lateWriter.write(batch);
+    }
+}
+
+void QThisPlayerSettings::stopWriter()
+{
+    if(! writerThread.isRunning())
+        return;
+
+    // the last batch has to be on disk before the process goes away
+    flushTimer.stop();
+    QHash<QString, QVariant> batch;
+    batch.swap(pending);
+
+    SettingsWriter* target = writer;
+    QMetaObject::invokeMethod(writer, [target, batch] { target->write(batch); }, Qt::BlockingQueuedConnection);
+
+    writerThread.quit();
+    writerThread.wait();
+    delete writer;
+    writer = nullptr;
+}
+
 bool QThisPlayerSettings::isRandom()
 {
-    return settings.value("random", false).toBool();
+    return value("random", false).toBool();
 }
 
 void QThisPlayerSettings::setRandom(bool random)
 {
-    settings.setValue("random", random);
+    setValue("random", random);
 }
 
 int QThisPlayerSettings::playlistMode()
 {
-    return settings.value("loop", 0).toInt();
+    return value("loop", 0).toInt();
 }
 
 void QThisPlayerSettings::setPlaylistMode(int loop)
 {
-    settings.setValue("loop", loop);
+    setValue("loop", loop);
 }
 
 int QThisPlayerSettings::volume()
 {
-    return settings.value("volume", 50).toInt();
+    return value("volume", 50).toInt();
 }
 
 void QThisPlayerSettings::setVolume(int volume)
 {
-    settings.setValue("volume", volume);
+    setValue("volume", volume);
 }
 
 bool QThisPlayerSettings::isMuted()
 {
-    return settings.value("mute", false).toBool();
+    return value("mute", false).toBool();
 }
 
 void QThisPlayerSettings::setMute(bool mute)
 {
-    settings.setValue("mute", mute);
+    setValue("mute", mute);
 }
 
 bool QThisPlayerSettings::seeRemainingTime()
 {
-    return settings.value("see_remaining_time", false).toBool();
+    return value("see_remaining_time", false).toBool();
 }
 
 void QThisPlayerSettings::setSeeRemainingTime(bool rt)
 {
-    settings.setValue("see_remaining_time", rt);
+    setValue("see_remaining_time", rt);
 }
 
 QString QThisPlayerSettings::lastOpenFoler()
 {
-    return settings.value("last_open_folder", QStandardPaths::writableLocation(QStandardPaths::MoviesLocation)).toString();
+    return value("last_open_folder", QStandardPaths::writableLocation(QStandardPaths::MoviesLocation)).toString();
 }
 
 void QThisPlayerSettings::setLastOpenFoler(const QString &folderPath)
 {
-    settings.setValue("last_open_folder", folderPath);
+    setValue("last_open_folder", folderPath);
 }
 
 bool QThisPlayerSettings::quitAtTheEndOfPlaylist()
 {
-    return settings.value("quit_at_the_end_of_playlist").toBool();
+    return value("quit_at_the_end_of_playlist").toBool();
 }
 
 void QThisPlayerSettings::setQuitAtTheEndOfPlaylist(bool checked)
 {
-    settings.setValue("quit_at_the_end_of_playlist", checked);
+    setValue("quit_at_the_end_of_playlist", checked);
 }
 
 QSize QThisPlayerSettings::mainWindowSize()
 {
-    return settings.value("mainwindow_size", QSize(600, 500)).toSize();
+    return value("mainwindow_size", QSize(600, 500)).toSize();
 }
 
 void QThisPlayerSettings::setMainWindowSize(QSize size)
 {
-    settings.setValue("mainwindow_size", size);
+    setValue("mainwindow_size", size);
 }
 
 QPoint QThisPlayerSettings::mainWindowPosition()
 {
-    return settings.value("mainwindow_position", QPoint(493, 135)).toPoint();;
+    return value("mainwindow_position", QPoint(493, 135)).toPoint();;
 }
 
 void QThisPlayerSettings::setMainWindowPosition(QPoint pos)
 {
-    settings.setValue("mainwindow_position", pos);
+    setValue("mainwindow_position", pos);
+}
+
+int QThisPlayerSettings::statsSamplingInterval()
+{
+    return value("stats_sampling_interval", 500).toInt();
+}
+
+void QThisPlayerSettings::setStatsSamplingInterval(int msec)
+{
+    setValue("stats_sampling_interval", msec);
+}
+
+int QThisPlayerSettings::performanceProfile()
+{
+    return value("performance_profile", PerformanceProfile::MAX_QUALITY).toInt();
+}
+
+void QThisPlayerSettings::setPerformanceProfile(int profile)
+{
+    setValue("performance_profile", profile);
+}
+
+bool QThisPlayerSettings::singleInstance()
+{
+    return value("single_instance", true).toBool();
+}
+
+void QThisPlayerSettings::setSingleInstance(bool single)
+{
+    setValue("single_instance", single);
+}
+
+bool QThisPlayerSettings::snapToKeyframes()
+{
+    return value("snap_to_keyframes", true).toBool();
+}
+
+void QThisPlayerSettings::setSnapToKeyframes(bool snap)
+{
+    setValue("snap_to_keyframes", snap);
+}
+
+QString QThisPlayerSettings::snapshotFormat()
+{
+    return value("snapshot_format", "png").toString();
+}
+
+void QThisPlayerSettings::setSnapshotFormat(const QString &format)
+{
+    setValue("snapshot_format", format);
+}
+
+bool QThisPlayerSettings::copySnapshotsToClipboard()
+{
+    return value("copy_snapshots_to_clipboard", false).toBool();
+}
+
+void QThisPlayerSettings::setCopySnapshotsToClipboard(bool copy)
+{
+    setValue("copy_snapshots_to_clipboard", copy);
+}
+
+QString QThisPlayerSettings::snapshotFolder()
+{
+    return value("snapshot_folder", "").toString();
+}
+
+void QThisPlayerSettings::setSnapshotFolder(const QString &folder)
+{
+    setValue("snapshot_folder", folder);
+}
+
+int QThisPlayerSettings::snapshotBurstCount()
+{
+    return value("snapshot_burst_count", 5).toInt();
+}
+
+int QThisPlayerSettings::snapshotBurstInterval()
+{
+    return value("snapshot_burst_interval", 200).toInt();
+}
+
+bool QThisPlayerSettings::renderThroughFramePool()
+{
+    return value("render_through_frame_pool", false).toBool();
+}
+
+void QThisPlayerSettings::setRenderThroughFramePool(bool enabled)
+{
+    setValue("render_through_frame_pool", enabled);
+}
+
+int QThisPlayerSettings::picInPicFrameRate()
+{
+    return value("pic_in_pic_frame_rate", 15).toInt();
+}
+
+void QThisPlayerSettings::setPicInPicFrameRate(int fps)
+{
+    setValue("pic_in_pic_frame_rate", fps);
+}
+
+bool QThisPlayerSettings::backgroundAudioOnly()
+{
+    return value("background_audio_only", true).toBool();
+}
+
+void QThisPlayerSettings::setBackgroundAudioOnly(bool enabled)
+{
+    setValue("background_audio_only", enabled);
+}
+
+int QThisPlayerSettings::stallThreshold()
+{
+    return value("stall_threshold", 50).toInt();
+}
+
+void QThisPlayerSettings::setStallThreshold(int msec)
+{
+    setValue("stall_threshold", msec);
 }
 
+bool QThisPlayerSettings::fastStart()
+{
+    return value("fast_start", false).toBool();
+}
 
+void QThisPlayerSettings::setFastStart(bool enabled)
+{
+    setValue("fast_start", enabled);
+}
 
+int QThisPlayerSettings::cachedPluginLoadTime()
+{
+    return value("cached_plugin_load_time", 0).toInt();
+}
 
+void QThisPlayerSettings::setCachedPluginLoadTime(int msec)
+{
+    setValue("cached_plugin_load_time", msec);
+}
+
+int QThisPlayerSettings::scannedPluginLoadTime()
+{
+    return value("scanned_plugin_load_time", 0).toInt();
+}
+
+void QThisPlayerSettings::setScannedPluginLoadTime(int msec)
+{
+    setValue("scanned_plugin_load_time", msec);
+}
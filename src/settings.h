@@ -21,15 +21,29 @@
 
 #include <QObject>
 #include <QSettings>
+#include <QHash>
+#include <QVariant>
+#include <QTimer>
+#include <QThread>
 
+class SettingsWriter;
+
+// Settings are read once into memory, the getters and setters only touch that
+// cache. Changes are written to disk in a batch by a background thread once
+// they stop coming in for a moment, and when the application quits.
 class QThisPlayerSettings : public QObject
 {
     Q_OBJECT
 
-    explicit QThisPlayerSettings(QObject *parent = nullptr) : QObject(parent) { }
+    explicit QThisPlayerSettings(QObject *parent = nullptr);
 
 public:
     static QThisPlayerSettings& singleton();
+    ~QThisPlayerSettings();
+
+    QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
+    void setValue(const QString& key, const QVariant& value);
+    void flush();
 
     bool isRandom();
     void setRandom(bool random);
@@ -49,9 +63,48 @@ public:
     void setMainWindowSize(QSize size);
     QPoint mainWindowPosition();
     void setMainWindowPosition(QPoint pos);
+    int statsSamplingInterval();
+    void setStatsSamplingInterval(int msec);
+    int performanceProfile();
+    void setPerformanceProfile(int profile);
+    bool singleInstance();
+    void setSingleInstance(bool single);
+    bool snapToKeyframes();
+    void setSnapToKeyframes(bool snap);
+    QString snapshotFormat();
+    void setSnapshotFormat(const QString& format);
+    bool copySnapshotsToClipboard();
+    void setCopySnapshotsToClipboard(bool copy);
+    QString snapshotFolder();
+    void setSnapshotFolder(const QString& folder);
+    int snapshotBurstCount();
+    int snapshotBurstInterval();
+    bool renderThroughFramePool();
+    void setRenderThroughFramePool(bool enabled);
+    int picInPicFrameRate();
+    void setPicInPicFrameRate(int fps);
+    bool backgroundAudioOnly();
+    void setBackgroundAudioOnly(bool enabled);
+    int stallThreshold();
+    void setStallThreshold(int msec);
+    bool fastStart();
+    void setFastStart(bool enabled);
+    int cachedPluginLoadTime();
+    void setCachedPluginLoadTime(int msec);
+    int scannedPluginLoadTime();
+    void setScannedPluginLoadTime(int msec);
+
+signals:
+    void changed(const QString& key, const QVariant& value);
 
 private:
-    QSettings settings;
+    void stopWriter();
+
+    QHash<QString, QVariant> cache;
+    QHash<QString, QVariant> pending;
+    QTimer flushTimer;
+    QThread writerThread;
+    SettingsWriter* writer;
 };
 
 #define Settings QThisPlayerSettings::singleton()
@@ -18,13 +18,11 @@
 
 #include "shared.h"
 
-#include <QTime>
-#include <QIcon>
+#include <QCryptographicHash>
+#include <QDateTime>
 
-const QStringList supportedSubtitlesFormats = {"cdg", "idx", "srt", "ssa", "aqt", "rt", "sami", "smi", "txt", "sub", "utf", "ass",
-                                               "jss", "psb", "dks", "pjs", "mpl2", "mks", "smil", "stl", "usf", "vtt", "tt", "ttml",
-                                               "dfxp", "scc"
-                                              };
+#include "mediaformats.h"
+#include "timeformat.h"
 
 QList<QFileInfo> filterSupportedMediaFormats(const QList<QUrl>& urls)
 {
@@ -34,10 +32,10 @@ QList<QFileInfo> filterSupportedMediaFormats(const QList<QUrl>& urls)
     {
         if(url.isLocalFile())
         {
-            QFileInfo localFile(url.toLocalFile());
+            QString path = url.toLocalFile();
 
-            if(supportedMediaFormats.contains(localFile.suffix(), Qt::CaseInsensitive))
-                files.append(localFile);
+            if(MediaFormats::isOfKind(path, MediaFormats::PLAYABLE))
+                files.append(QFileInfo(path));
         }
     }
 
@@ -50,9 +48,7 @@ bool areAllSubtitleFiles(const QList<QUrl> &urls)
     {
         if(url.isLocalFile())
         {
-            QFileInfo localFile(url.toLocalFile());
-
-            if( ! supportedSubtitlesFormats.contains(localFile.suffix(), Qt::CaseInsensitive))
+            if( ! MediaFormats::isOfKind(url.toLocalFile(), MediaFormats::SUBTITLE))
                 return false;
         }
         else
@@ -62,43 +58,18 @@ bool areAllSubtitleFiles(const QList<QUrl> &urls)
     return true;
 }
 
-QString formattedTime(int millSec)
+QString formattedTime(qint64 millSec)
 {
-    QTime time = QTime(0, 0);
-    time = time.addMSecs(millSec);
-
-    QString displayFormat = "mm:ss";
-    if (time.hour() > 0)
-        displayFormat = "hh:mm:ss";
-
-    return  time.toString(displayFormat);;
+    char buffer[TIME_TEXT_CAPACITY];
+    return QString::fromLatin1(buffer, formatTime(millSec, buffer));
 }
 
-QIcon invertedColorIcon(QIcon icon)
+QString fileFingerprint(const QString &filePath)
 {
-    /* ---- For all the states ----------*/
-//    QIcon invertedIcon;
-//    for(auto singleMode : {QIcon::Normal,QIcon::Disabled,QIcon::Active,QIcon::Selected}){
-//    for(auto singleState : {QIcon::On,QIcon::Off}){
-//    const auto avalSize = myIcon.availableSizes(singleMode ,singleState );
-//    for(auto& singleSize : avalSize){
-//    QImage tempImage = myIcon.pixmap(singleSize,singleMode ,singleState).toImage();
-//    tempImage.invertPixels();
-//    invertedIcon.addPixmap(QPixmap::fromImage(std::move(tempImage)),singleMode,singleState);
-//    }
-//    }
-//    }
-
-    const auto avalSize = icon.availableSizes();
-
-    QIcon invertedIcon;
-
-    for(auto& singleSize : avalSize)
-    {
-        QImage tempImage = icon.pixmap(singleSize).toImage();
-        tempImage.invertPixels();
-        invertedIcon.addPixmap(QPixmap::fromImage(std::move(tempImage)));
-    }
+    // changes whenever the file is replaced or modified, used to key on-disk caches
+    QFileInfo info(filePath);
+    QByteArray key = info.absoluteFilePath().toUtf8() + '\0' + QByteArray::number(info.size()) + '\0' +
+            QByteArray::number(info.lastModified().toMSecsSinceEpoch());
 
-    return invertedIcon;
+    return QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
 }
@@ -0,0 +1,161 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "singleinstance.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDebug>
+
+const int CONNECT_TIMEOUT = 500;
+const int WRITE_TIMEOUT = 1000;
+// a burst of "Open with" processes takes a few rounds to settle on one server
+const int START_ATTEMPTS = 5;
+
+static QString serverName()
+{
+    // one server per user, the home path keeps the name short and free of separators
+    QByteArray user = QDir::homePath().toUtf8();
+    return QCoreApplication::applicationName() + "-" + QCryptographicHash::hash(user, QCryptographicHash::Md5).toHex().left(12);
+}
+
+SingleInstance::SingleInstance(QObject *parent)
+    : QObject(parent),
+      server(nullptr)
+{
+}
+
+// Message format: the command ("play" or "enqueue") followed by one absolute
+// file path per line, UTF-8 encoded. The connection is closed when done.
+bool SingleInstance::forwardToRunningInstance(const QStringList &arguments)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName());
+    if(! socket.waitForConnected(CONNECT_TIMEOUT))
+        return false;
+
+    QStringList lines;
+    lines << (isEnqueueRequested(arguments) ? "enqueue" : "play");
+    for(const QUrl& file : filesFromArguments(arguments))
+        lines << file.toLocalFile();
+
+    socket.write(lines.join('\n').toUtf8());
+    bool written = socket.waitForBytesWritten(WRITE_TIMEOUT);
+    socket.disconnectFromServer();
+    if(socket.state() != QLocalSocket::UnconnectedState)
+        socket.waitForDisconnected(WRITE_TIMEOUT);
+
+    return written;
+}
+
+// returns true when the files went to a running instance and this process can quit
+bool SingleInstance::forwardOrListen(const QStringList &arguments)
+{
+    for(int attempt = 0; attempt < START_ATTEMPTS; ++attempt)
+    {
+        if(forwardToRunningInstance(arguments))
+            return true;
+
+        // lost the race to a process that started at the same time, hand the files to it
+        if(listen() != ANOTHER_INSTANCE_LISTENING)
+            return false;
+    }
+
+    qWarning() << "Single instance: could neither reach nor replace the running instance";
+    return false;
+}
+
+SingleInstance::ListenResult SingleInstance::listen()
+{
+    if(! server)
+    {
+        server = new QLocalServer(this);
+        server->setSocketOptions(QLocalServer::UserAccessOption);
+        connect(server, &QLocalServer::newConnection, this, &SingleInstance::onNewConnection);
+    }
+
+    if(server->listen(serverName()))
+        return LISTENING;
+
+    // the name is taken, either by a live instance or by the socket file a crashed one left
+    // behind on unix; only a socket nobody answers on may be removed
+    QLocalSocket probe;
+    probe.connectToServer(serverName());
+    if(probe.waitForConnected(CONNECT_TIMEOUT))
+    {
+        probe.disconnectFromServer();
+        return ANOTHER_INSTANCE_LISTENING;
+    }
+
+    QLocalServer::removeServer(serverName());
+    if(server->listen(serverName()))
+        return LISTENING;
+
+    qWarning() << "Single instance: could not listen on" << serverName() << server->errorString();
+    return FAILED;
+}
+
+bool SingleInstance::isEnqueueRequested(const QStringList &arguments)
+{
+    return arguments.contains("--enqueue");
+}
+
+bool SingleInstance::isNewInstanceRequested(const QStringList &arguments)
+{
+    return arguments.contains("--new-instance");
+}
+
+QList<QUrl> SingleInstance::filesFromArguments(const QStringList &arguments)
+{
+    QList<QUrl> files;
+    for(int i = 1; i < arguments.size(); ++i)
+    {
+        // command line switches such as --startup-trace are not files
+        if(arguments.at(i).startsWith("--"))
+            continue;
+
+        // the running instance has its own working directory
+        files << QUrl::fromLocalFile(QFileInfo(arguments.at(i)).absoluteFilePath());
+    }
+    return files;
+}
+
+void SingleInstance::onNewConnection()
+{
+    while(QLocalSocket* socket = server->nextPendingConnection())
+    {
+        connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]
+        {
+            QStringList lines = QString::fromUtf8(socket->readAll()).split('\n', Qt::SkipEmptyParts);
+            if(lines.isEmpty())
+                return;
+
+            bool play = (lines.takeFirst() != "enqueue");
+            QList<QUrl> files;
+            for(const QString& line : qAsConst(lines))
+                files << QUrl::fromLocalFile(line);
+
+            emit filesReceived(files, play);
+        });
+    }
+}
@@ -0,0 +1,61 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef SINGLEINSTANCE_H
+#define SINGLEINSTANCE_H
+
+#include <QObject>
+#include <QList>
+#include <QUrl>
+
+class QLocalServer;
+
+// Hands the files of a second invocation over to the running player through
+// a local socket, so opening from the file manager does not start a new process
+// with its own libvlc instance.
+class SingleInstance : public QObject
+{
+    Q_OBJECT
+public:
+    enum ListenResult
+    {
+        LISTENING,
+        ANOTHER_INSTANCE_LISTENING,
+        FAILED
+    };
+
+    explicit SingleInstance(QObject *parent = nullptr);
+
+    bool forwardOrListen(const QStringList& arguments);
+    bool forwardToRunningInstance(const QStringList& arguments);
+    ListenResult listen();
+
+    static bool isEnqueueRequested(const QStringList& arguments);
+    static bool isNewInstanceRequested(const QStringList& arguments);
+    static QList<QUrl> filesFromArguments(const QStringList& arguments);
+
+signals:
+    void filesReceived(const QList<QUrl>& files, bool play);
+
+private:
+    void onNewConnection();
+
+    QLocalServer* server;
+};
+
+#endif // SINGLEINSTANCE_H
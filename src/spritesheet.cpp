@@ -0,0 +1,177 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "spritesheet.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <cstring>
+
+#include "shared.h"
+
+const char SHEET_MAGIC[8] = {'Q', 'T', 'P', 'S', 'P', 'R', 'T', '1'};
+// magic, tile count, interval
+const int HEADER_SIZE = 16;
+// offset and size of every tile
+const int TABLE_ENTRY_SIZE = 8;
+const qint64 MIN_INTERVAL = 10000;
+const int MAX_TILES = 360;
+
+static QString cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/sprites";
+}
+
+SpriteSheet::SpriteSheet()
+    : data(nullptr),
+      dataSize(0),
+      count(0),
+      tileInterval(0)
+{
+}
+
+bool SpriteSheet::isEmpty() const
+{
+    return count == 0;
+}
+
+int SpriteSheet::tileCount() const
+{
+    return count;
+}
+
+qint64 SpriteSheet::interval() const
+{
+    return tileInterval;
+}
+
+int SpriteSheet::tileIndexAt(qint64 time) const
+{
+    if(count == 0)
+        return -1;
+
+    return int(qBound<qint64>(0, time / tileInterval, count - 1));
+}
+
+qint64 SpriteSheet::tileTime(int index) const
+{
+    return index * tileInterval;
+}
+
+QImage SpriteSheet::tile(int index) const
+{
+    if(index < 0 || index >= count)
+        return QImage();
+
+    const uchar* entry = data + HEADER_SIZE + index * TABLE_ENTRY_SIZE;
+    quint32 offset = qFromLittleEndian<quint32>(entry);
+    quint32 size = qFromLittleEndian<quint32>(entry + 4);
+    if(size == 0 || offset + qint64(size) > dataSize)
+        return QImage();
+
+    return QImage::fromData(data + offset, int(size), "JPG");
+}
+
+qint64 SpriteSheet::intervalFor(qint64 length)
+{
+    // whole seconds, and never more tiles than a seek bar can tell apart
+    qint64 interval = qMax(MIN_INTERVAL, (length + MAX_TILES - 1) / MAX_TILES);
+    return (interval + 999) / 1000 * 1000;
+}
+
+QString SpriteSheet::cachePath(const QString &filePath)
+{
+    return cacheDirectory() + "/" + fileFingerprint(filePath) + ".sprites";
+}
+
+bool SpriteSheet::load(const QString &filePath, SpriteSheet *sheet)
+{
+    QSharedPointer<QFile> file(new QFile(cachePath(filePath)));
+    if(! file->open(QIODevice::ReadOnly) || file->size() < HEADER_SIZE)
+        return false;
+
+    const uchar* data = file->map(0, file->size());
+    if(! data || std::memcmp(data, SHEET_MAGIC, sizeof(SHEET_MAGIC)) != 0)
+        return false;
+
+    quint32 count = qFromLittleEndian<quint32>(data + 8);
+    quint32 interval = qFromLittleEndian<quint32>(data + 12);
+    if(interval == 0 || HEADER_SIZE + qint64(count) * TABLE_ENTRY_SIZE > file->size())
+        return false;
+
+    // the modification time is what eviction goes by, a used sheet is a recent one
+    file->setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    sheet->file = file;
+    sheet->data = data;
+    sheet->dataSize = file->size();
+    sheet->count = int(count);
+    sheet->tileInterval = interval;
+    return true;
+}
+
+bool SpriteSheet::save(const QString &filePath, qint64 interval, const QVector<QByteArray> &jpegTiles)
+{
+    QString path = cachePath(filePath);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if(! file.open(QIODevice::WriteOnly))
+        return false;
+
+    QByteArray header(HEADER_SIZE + jpegTiles.size() * TABLE_ENTRY_SIZE, '\0');
+    uchar* out = reinterpret_cast<uchar*>(header.data());
+    std::memcpy(out, SHEET_MAGIC, sizeof(SHEET_MAGIC));
+    qToLittleEndian<quint32>(quint32(jpegTiles.size()), out + 8);
+    qToLittleEndian<quint32>(quint32(interval), out + 12);
+
+    quint32 offset = quint32(header.size());
+    for(int i = 0; i < jpegTiles.size(); ++i)
+    {
+        uchar* entry = out + HEADER_SIZE + i * TABLE_ENTRY_SIZE;
+        qToLittleEndian<quint32>(offset, entry);
+        qToLittleEndian<quint32>(quint32(jpegTiles.at(i).size()), entry + 4);
+        offset += quint32(jpegTiles.at(i).size());
+    }
+
+    file.write(header);
+    for(const QByteArray& tile : jpegTiles)
+        file.write(tile);
+
+    return file.commit();
+}
+
+void SpriteSheet::evictCache(qint64 maxBytes)
+{
+    QDir dir(cacheDirectory());
+    // newest first, whatever does not fit after them goes
+    QFileInfoList sheets = dir.entryInfoList({"*.sprites"}, QDir::Files, QDir::Time);
+
+    qint64 total = 0;
+    for(const QFileInfo& info : sheets)
+    {
+        total += info.size();
+        if(total > maxBytes)
+            QFile::remove(info.absoluteFilePath());
+    }
+}
@@ -0,0 +1,60 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef SPRITESHEET_H
+#define SPRITESHEET_H
+
+#include <QImage>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+class QFile;
+
+// Preview frames of a whole file taken every interval() ms, stored in the
+// cache directory as one file: a header, a table of tile offsets and the
+// tiles as JPEG. Loaded sheets stay memory-mapped, so a preview is one small
+// decode straight from the mapping. Copies share the mapping.
+class SpriteSheet
+{
+public:
+    SpriteSheet();
+
+    bool isEmpty() const;
+    int tileCount() const;
+    qint64 interval() const;
+    int tileIndexAt(qint64 time) const;
+    qint64 tileTime(int index) const;
+    QImage tile(int index) const;
+
+    static qint64 intervalFor(qint64 length);
+    static QString cachePath(const QString& filePath);
+    static bool load(const QString& filePath, SpriteSheet* sheet);
+    // null tiles are stored empty and come back as null images
+    static bool save(const QString& filePath, qint64 interval, const QVector<QByteArray>& jpegTiles);
+    static void evictCache(qint64 maxBytes);
+
+private:
+    QSharedPointer<QFile> file;
+    const uchar* data;
+    qint64 dataSize;
+    int count;
+    qint64 tileInterval;
+};
+
+#endif // SPRITESHEET_H
@@ -0,0 +1,286 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "stallwatchdog.h"
+
+#include <QCoreApplication>
+#include <QAbstractEventDispatcher>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QDebug>
+
+const int MAX_MARKER_DEPTH = 16;
+const int SAMPLE_INTERVAL = 5;
+const int HANG_WARNING = 2000;
+const int REPORT_BUCKETS[] = {16, 50, 200, 1000};
+
+// written by the GUI thread only, read by the watchdog thread while it stalls
+static std::atomic<const char*> markerStack[MAX_MARKER_DEPTH];
+static std::atomic<int> markerDepth(0);
+
+StallWatchdog* StallWatchdog::self = nullptr;
+
+StallWatchdog::Marker::Marker(const char *operation)
+    : name(nullptr),
+      startedAt(0)
+{
+    // markers in code shared with worker threads only count on the GUI thread
+    if(self == nullptr || QThread::currentThread() != self->thread())
+        return;
+
+    name = operation;
+    startedAt = self->clock.elapsed();
+
+    int depth = markerDepth.load(std::memory_order_relaxed);
+    if(depth < MAX_MARKER_DEPTH)
+        markerStack[depth].store(name, std::memory_order_relaxed);
+    markerDepth.store(depth + 1, std::memory_order_release);
+}
+
+StallWatchdog::Marker::~Marker()
+{
+    if(name == nullptr || self == nullptr)
+        return;
+
+    markerDepth.store(markerDepth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+
+    // covers stalls that end before the watchdog thread got to sample them
+    qint64 duration = self->clock.elapsed() - startedAt;
+    if(duration > self->slowestMarkerDuration)
+    {
+        self->slowestMarker = name;
+        self->slowestMarkerDuration = duration;
+    }
+}
+
+StallWatchdog::StallWatchdog(int threshold, QObject *parent)
+    : QObject(parent),
+      mThreshold(qMax(1, threshold)),
+      busySince(0),
+      busyPeriod(0),
+      watcherWaiting(false),
+      stopping(false),
+      sampledPeriod(0),
+      count(0),
+      slowestMarker(nullptr),
+      slowestMarkerDuration(0)
+{
+    clock.start();
+    self = this;
+
+    QAbstractEventDispatcher* dispatcher = QAbstractEventDispatcher::instance(thread());
+    connect(dispatcher, &QAbstractEventDispatcher::awake, this, &StallWatchdog::onAwake, Qt::DirectConnection);
+    connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &StallWatchdog::onAboutToBlock, Qt::DirectConnection);
+
+    watcher = QThread::create([this] { watch(); });
+    watcher->setObjectName("StallWatchdog");
+    watcher->start(QThread::HighPriority);
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        wakeUp.wakeAll();
+    }
+
+    watcher->wait();
+    delete watcher;
+    self = nullptr;
+}
+
+StallWatchdog *StallWatchdog::instance()
+{
+    return self;
+}
+
+int StallWatchdog::threshold() const
+{
+    return mThreshold.load();
+}
+
+void StallWatchdog::setThreshold(int msec)
+{
+    mThreshold.store(qMax(1, msec));
+}
+
+int StallWatchdog::stallCount() const
+{
+    return count;
+}
+
+const StallWatchdog::History &StallWatchdog::history() const
+{
+    return stalls;
+}
+
+void StallWatchdog::onAwake()
+{
+    busyPeriod.fetch_add(1);
+    busySince.store(clock.elapsed() + 1);
+
+    // only pay for the lock when the watchdog thread is parked waiting for work
+    if(watcherWaiting.load())
+    {
+        QMutexLocker locker(&mutex);
+        wakeUp.wakeOne();
+    }
+}
+
+void StallWatchdog::onAboutToBlock()
+{
+    qint64 since = busySince.exchange(0);
+    const char* marker = slowestMarker;
+    slowestMarker = nullptr;
+    slowestMarkerDuration = 0;
+
+    if(since == 0)
+        return;
+
+    qint64 duration = clock.elapsed() - (since - 1);
+    if(duration < mThreshold.load())
+        return;
+
+    Stall stall;
+    stall.startedAt = QDateTime::currentDateTime().addMSecs(-duration);
+    stall.duration = int(duration);
+
+    {
+        QMutexLocker locker(&mutex);
+        if(sampledPeriod == busyPeriod.load())
+            stall.operation = sampledOperation;
+    }
+
+    if(stall.operation.isEmpty() && marker)
+        stall.operation = marker;
+
+    stalls.push(stall);
+    ++count;
+}
+
+void StallWatchdog::watch()
+{
+    QMutexLocker locker(&mutex);
+
+    while(! stopping)
+    {
+        watcherWaiting.store(true);
+        while(! stopping && busySince.load() == 0)
+            wakeUp.wait(&mutex);
+        watcherWaiting.store(false);
+
+        quint64 period = busyPeriod.load();
+        qint64 since = busySince.load();
+
+        if(stopping || since == 0)
+            continue;
+
+        // sleep until this busy period would turn into a stall
+        qint64 remaining = (since - 1) + mThreshold.load() - clock.elapsed();
+        if(remaining > 0)
+            wakeUp.wait(&mutex, ulong(remaining));
+
+        bool warned = false;
+        while(! stopping && busyPeriod.load() == period && busySince.load() != 0)
+        {
+            if(sampledPeriod != period)
+            {
+                // keep the first operation caught, the one that went over the threshold
+                QString operation = activeOperations();
+                if(! operation.isEmpty())
+                {
+                    sampledOperation = operation;
+                    sampledPeriod = period;
+                }
+            }
+
+            qint64 busyFor = clock.elapsed() - (since - 1);
+            if(busyFor > HANG_WARNING && ! warned)
+            {
+                qWarning() << "StallWatchdog: GUI thread busy for" << busyFor << "ms in"
+                           << (sampledPeriod == period ? sampledOperation : QString("an unmarked operation"));
+                warned = true;
+            }
+
+            wakeUp.wait(&mutex, SAMPLE_INTERVAL);
+        }
+    }
+}
+
+QString StallWatchdog::activeOperations()
+{
+    int depth = qMin(markerDepth.load(std::memory_order_acquire), MAX_MARKER_DEPTH);
+
+    QStringList names;
+    for(int i = 0; i < depth; ++i)
+    {
+        const char* name = markerStack[i].load(std::memory_order_relaxed);
+        if(name)
+            names.append(QString::fromLatin1(name));
+    }
+
+    return names.join(" > ");
+}
+
+QString StallWatchdog::report() const
+{
+    QString text = QString("%1 GUI thread stalls over %2 ms").arg(count).arg(threshold());
+
+    if(stalls.isEmpty())
+        return text;
+
+    for(int bucket : REPORT_BUCKETS)
+    {
+        int over = 0;
+        for(std::size_t i = 0; i < stalls.size(); ++i)
+            over += stalls.at(i).duration >= bucket ? 1 : 0;
+        text += QString("\n>= %1 ms: %2").arg(bucket).arg(over);
+    }
+
+    text += QString("\n\nLast %1:").arg(stalls.size());
+
+    for(std::size_t i = stalls.size(); i-- > 0;)
+    {
+        const Stall& stall = stalls.at(i);
+        text += QString("\n%1  %2 ms  %3").arg(stall.startedAt.toString("HH:mm:ss.zzz"))
+                .arg(stall.duration, 5)
+                .arg(stall.operation.isEmpty() ? QString("(unmarked)") : stall.operation);
+    }
+
+    return text;
+}
+
+bool StallWatchdog::writeLog(const QString &filePath) const
+{
+    QFile file(filePath);
+
+    if(! file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qWarning() << "StallWatchdog: cannot write" << filePath;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "QThisPlayer " << QCoreApplication::applicationVersion() << ", session ending "
+        << QDateTime::currentDateTime().toString(Qt::ISODate) << '\n'
+        << report() << '\n';
+
+    return true;
+}
@@ -0,0 +1,113 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <atomic>
+
+#include "ringbuffer.h"
+
+#define STALL_MARKER_CONCAT_(a, b) a##b
+#define STALL_MARKER_CONCAT(a, b) STALL_MARKER_CONCAT_(a, b)
+
+// Names what the GUI thread is doing until the end of the scope. The name has
+// to be a string literal, the watchdog thread reads it without copying.
+#define STALL_MARKER(name) StallWatchdog::Marker STALL_MARKER_CONCAT(stallMarker, __LINE__)(name)
+
+// Watches the GUI thread from a thread of its own and records every stretch
+// it spends away from the event loop for longer than the threshold, together
+// with the markers that were active at the time. The GUI thread only flags
+// when its event loop wakes up and when it goes back to sleep, nothing is
+// posted to it, so the watchdog never wakes up an idle player.
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+public:
+    struct Stall
+    {
+        QDateTime startedAt;
+        int duration;           // ms
+        QString operation;      // active markers, outermost first
+    };
+
+    enum { HISTORY_SIZE = 128 };
+    typedef RingBuffer<Stall, HISTORY_SIZE> History;
+
+    class Marker
+    {
+    public:
+        explicit Marker(const char* operation);
+        ~Marker();
+
+    private:
+        Q_DISABLE_COPY(Marker)
+
+        const char* name;
+        qint64 startedAt;
+    };
+
+    explicit StallWatchdog(int threshold, QObject *parent = nullptr);
+    ~StallWatchdog();
+
+    static StallWatchdog* instance();
+
+    int threshold() const;
+    void setThreshold(int msec);
+    int stallCount() const;
+    const History& history() const;
+    QString report() const;
+    bool writeLog(const QString& filePath) const;
+
+private:
+    void watch();
+    void onAwake();
+    void onAboutToBlock();
+    static QString activeOperations();
+
+    static StallWatchdog* self;
+
+    QElapsedTimer clock;
+    std::atomic<int> mThreshold;
+    std::atomic<qint64> busySince;  // clock time + 1, 0 while the event loop sleeps
+    std::atomic<quint64> busyPeriod;
+    std::atomic<bool> watcherWaiting;
+
+    // shared with the watchdog thread
+    QMutex mutex;
+    QWaitCondition wakeUp;
+    bool stopping;
+    QString sampledOperation;
+    quint64 sampledPeriod;
+
+    // GUI thread only
+    History stalls;
+    int count;
+    const char* slowestMarker;
+    qint64 slowestMarkerDuration;
+
+    QThread* watcher;
+};
+
+#endif // STALLWATCHDOG_H
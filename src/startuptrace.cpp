@@ -0,0 +1,195 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "startuptrace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <QStringList>
+#include <QDebug>
+#include <cstring>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#endif
+
+struct PhaseBudget
+{
+    const char *phase;
+    qint64 msec;
+};
+
+// cumulative budgets, measured from the start of main()
+const PhaseBudget PHASE_BUDGETS[] =
+{
+    {"application created", 150},
+    {"vlc instance created", 400},
+    {"main window constructed", 600},
+    {"main window shown", 800},
+    {"event loop running", 1000},
+    {"first frame", 2500}
+};
+const int FIRST_FRAME_TIMEOUT = 30000;
+
+struct Phase
+{
+    const char *name;
+    qint64 nsecs;
+};
+
+static QElapsedTimer startupClock;
+static QVector<Phase> phases;
+static QStringList notes;
+static bool enabled = false;
+static bool checkBudgets = false;
+static bool expectsFirstFrame = false;
+static bool finished = false;
+
+// in KiB, 0 where the platform does not tell
+static qint64 residentMemory()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return qint64(counters.WorkingSetSize) / 1024;
+#elif defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if(status.open(QIODevice::ReadOnly))
+    {
+        for(const QByteArray& line : status.readAll().split('\n'))
+        {
+            if(line.startsWith("VmRSS:"))
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+#endif
+    return 0;
+}
+
+void StartupTrace::start(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--startup-trace") == 0)
+        {
+            enabled = true;
+        }
+        else if(std::strcmp(argv[i], "--startup-trace-check") == 0)
+        {
+            enabled = true;
+            checkBudgets = true;
+        }
+        else if(std::strncmp(argv[i], "--", 2) != 0)
+        {
+            // a file to open, so the trace runs until its first frame
+            expectsFirstFrame = true;
+        }
+    }
+
+    if(! enabled)
+        return;
+
+    phases.reserve(16);
+    startupClock.start();
+    mark("main");
+}
+
+bool StartupTrace::isEnabled()
+{
+    return enabled && ! finished;
+}
+
+void StartupTrace::mark(const char *phase)
+{
+    if(! isEnabled())
+        return;
+
+    phases.append({phase, startupClock.nsecsElapsed()});
+}
+
+// printed under the timeline, for what a phase name alone does not tell
+void StartupTrace::note(const QString &text)
+{
+    if(! isEnabled())
+        return;
+
+    notes.append(text);
+}
+
+void StartupTrace::eventLoopStarted()
+{
+    if(! isEnabled())
+        return;
+
+    mark("event loop running");
+
+    if(! expectsFirstFrame)
+        finish();
+    else
+        QTimer::singleShot(FIRST_FRAME_TIMEOUT, [] { finish(); });
+}
+
+void StartupTrace::finish()
+{
+    if(! isEnabled())
+        return;
+
+    finished = true;
+
+    bool overBudget = false;
+    qint64 previous = 0;
+
+    qInfo().noquote() << "Startup trace:";
+    for(const Phase& phase : qAsConst(phases))
+    {
+        qint64 msec = phase.nsecs / 1000000;
+        QString line = QString("  %1 ms  %2 (+%3 ms)").arg(msec, 6).arg(phase.name).arg((phase.nsecs - previous) / 1000000);
+        previous = phase.nsecs;
+
+        for(const PhaseBudget& budget : PHASE_BUDGETS)
+        {
+            if(std::strcmp(budget.phase, phase.name) == 0 && msec > budget.msec)
+            {
+                line += QString("  OVER BUDGET (%1 ms)").arg(budget.msec);
+                overBudget = true;
+            }
+        }
+        qInfo().noquote() << line;
+    }
+
+    for(const QString& text : qAsConst(notes))
+        qInfo().noquote() << "  note:" << text;
+
+    qint64 resident = residentMemory();
+    if(resident > 0)
+        qInfo().noquote() << QString("  resident memory: %1 MiB").arg(resident / 1024.0, 0, 'f', 1);
+
+    if(expectsFirstFrame && std::strcmp(phases.last().name, "first frame") != 0)
+    {
+        qWarning() << "Startup trace: no frame was shown within" << FIRST_FRAME_TIMEOUT << "ms";
+        overBudget = true;
+    }
+
+    if(checkBudgets)
+        QCoreApplication::exit(overBudget ? 1 : 0);
+}
@@ -0,0 +1,39 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QString>
+
+// Phase timestamps from main() to the first video frame. Enabled with
+// --startup-trace, which prints the timeline once startup is over, or with
+// --startup-trace-check, which also quits with exit code 1 when a phase went
+// over its budget so a script can catch startup regressions.
+class StartupTrace
+{
+public:
+    static void start(int argc, char *argv[]);
+    static bool isEnabled();
+    static void mark(const char *phase);
+    static void note(const QString& text);
+    static void eventLoopStarted();
+    static void finish();
+};
+
+#endif // STARTUPTRACE_H
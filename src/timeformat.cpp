@@ -0,0 +1,139 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "timeformat.h"
+
+#include <limits>
+
+static int writeNumber(quint64 value, int minimumDigits, char *buffer)
+{
+    char digits[20];
+    int count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    while(value > 0);
+
+    while(count < minimumDigits)
+        digits[count++] = '0';
+
+    for(int i = 0; i < count; ++i)
+        buffer[i] = digits[count - 1 - i];
+
+    return count;
+}
+
+int formatTime(qint64 msec, char *buffer)
+{
+    quint64 totalSeconds = (msec > 0) ? static_cast<quint64>(msec) / 1000 : 0;
+    quint64 hours = totalSeconds / 3600;
+    int minutes = static_cast<int>((totalSeconds / 60) % 60);
+    int seconds = static_cast<int>(totalSeconds % 60);
+
+    int length = 0;
+    if(hours > 0)
+    {
+        length += writeNumber(hours, 2, buffer);
+        buffer[length++] = ':';
+    }
+    length += writeNumber(minutes, 2, buffer + length);
+    buffer[length++] = ':';
+    length += writeNumber(seconds, 2, buffer + length);
+    buffer[length] = '\0';
+
+    return length;
+}
+
+qint64 parseTime(const QChar *text, int length, bool *ok)
+{
+    qint64 parts[3] = {0, 0, 0};
+    int partCount = 0;
+    int digitsInPart = 0;
+
+    for(int i = 0; i <= length; ++i)
+    {
+        if(i == length || text[i] == QLatin1Char(':'))
+        {
+            if(digitsInPart == 0 || partCount == 3)
+            {
+                partCount = 0;
+                break;
+            }
+            ++partCount;
+            digitsInPart = 0;
+        }
+        else if(text[i] >= QLatin1Char('0') && text[i] <= QLatin1Char('9') && digitsInPart < 9 && partCount < 3)
+        {
+            parts[partCount] = parts[partCount] * 10 + (text[i].unicode() - '0');
+            ++digitsInPart;
+        }
+        else
+        {
+            partCount = 0;
+            break;
+        }
+    }
+
+    if(ok)
+        *ok = (partCount > 0);
+
+    if(partCount == 0)
+        return -1;
+
+    // the last part is always the seconds
+    qint64 seconds = 0;
+    for(int i = 0; i < partCount; ++i)
+        seconds = seconds * 60 + parts[i];
+
+    return seconds * 1000;
+}
+
+qint64 parseTime(const QString &text, bool *ok)
+{
+    return parseTime(text.constData(), text.size(), ok);
+}
+
+TimeText::TimeText()
+    : second(std::numeric_limits<qint64>::min())
+{
+}
+
+bool TimeText::setTime(qint64 msec)
+{
+    qint64 newSecond = (msec > 0) ? msec / 1000 : 0;
+    if(newSecond == second)
+        return false;
+
+    second = newSecond;
+
+    char buffer[TIME_TEXT_CAPACITY];
+    cachedText = QString::fromLatin1(buffer, formatTime(msec, buffer));
+    return true;
+}
+
+const QString &TimeText::text() const
+{
+    return cachedText;
+}
+
+void TimeText::reset()
+{
+    second = std::numeric_limits<qint64>::min();
+}
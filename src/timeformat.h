@@ -0,0 +1,51 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef TIMEFORMAT_H
+#define TIMEFORMAT_H
+
+#include <QString>
+
+// Enough for "-" + the hours of a qint64 + ":mm:ss" and the terminating zero.
+const int TIME_TEXT_CAPACITY = 32;
+
+// Writes "mm:ss", or "hh:mm:ss" once there are hours, into buffer and returns
+// the number of characters written. Hours are not wrapped at 24 like QTime does.
+int formatTime(qint64 msec, char *buffer);
+
+// Parses "s", "m:ss" or "h:mm:ss" into milliseconds. Returns -1 and sets ok
+// to false when the text is not a time.
+qint64 parseTime(const QChar *text, int length, bool *ok = nullptr);
+qint64 parseTime(const QString& text, bool *ok = nullptr);
+
+// Text for a time label, only rebuilt when the displayed second changes.
+class TimeText
+{
+public:
+    TimeText();
+
+    bool setTime(qint64 msec);
+    const QString& text() const;
+    void reset();
+
+private:
+    qint64 second;
+    QString cachedText;
+};
+
+#endif // TIMEFORMAT_H
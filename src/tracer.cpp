@@ -0,0 +1,271 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QQueue>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QDebug>
+#include <atomic>
+#include <cstring>
+
+// ~650 KB per thread that records anything, later events are dropped
+const int EVENTS_PER_THREAD = 16384;
+// buffers of exited threads kept for the export, older ones go to new threads
+const int RETIRED_BUFFERS_KEPT = 8;
+
+struct TraceEvent
+{
+    const char* name;
+    char phase;         // 'X' complete, 'i' instant, 'b'/'e' async begin/end
+    qint64 timestamp;   // us since the tracer started
+    qint64 duration;
+    quint64 id;
+};
+
+struct ThreadBuffer
+{
+    quint64 threadId;
+    QString threadName;
+    std::atomic<int> count;     // events below count are complete
+    std::atomic<int> dropped;
+    TraceEvent events[EVENTS_PER_THREAD];
+};
+
+static QElapsedTimer traceClock;
+static std::atomic<bool> enabled(false);
+static QString exitFilePath;
+
+// a buffer outlives its thread, so a trace still covers threads that are gone
+// by the time it is exported; pool threads come and go though, so only the
+// last few exited threads are kept and their buffers are handed to new ones
+static QMutex buffersMutex;
+static QVector<ThreadBuffer*> buffers;
+static QQueue<ThreadBuffer*> retiredBuffers;
+
+struct ThreadBufferHolder
+{
+    ThreadBuffer* buffer = nullptr;
+
+    ~ThreadBufferHolder()
+    {
+        if(! buffer)
+            return;
+
+        QMutexLocker locker(&buffersMutex);
+        retiredBuffers.enqueue(buffer);
+    }
+};
+
+static thread_local ThreadBufferHolder threadBuffer;
+
+static qint64 now()
+{
+    return traceClock.nsecsElapsed() / 1000;
+}
+
+static ThreadBuffer* currentBuffer()
+{
+    if(threadBuffer.buffer)
+        return threadBuffer.buffer;
+
+    QMutexLocker locker(&buffersMutex);
+
+    ThreadBuffer* buffer;
+    if(retiredBuffers.size() >= RETIRED_BUFFERS_KEPT)
+    {
+        buffer = retiredBuffers.dequeue();
+    }
+    else
+    {
+        buffer = new ThreadBuffer;
+        buffers.append(buffer);
+    }
+
+    buffer->threadId = quint64(quintptr(QThread::currentThreadId()));
+    buffer->count.store(0);
+    buffer->dropped.store(0);
+
+    QThread* thread = QThread::currentThread();
+    if(QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+        buffer->threadName = "GUI";
+    else if(! thread->objectName().isEmpty())
+        buffer->threadName = thread->objectName();
+    else
+        buffer->threadName = QString("thread %1").arg(buffer->threadId);
+
+    threadBuffer.buffer = buffer;
+    return buffer;
+}
+
+static void record(const char* name, char phase, qint64 timestamp, qint64 duration, quint64 id)
+{
+    ThreadBuffer* buffer = currentBuffer();
+    int index = buffer->count.load(std::memory_order_relaxed);
+
+    if(index >= EVENTS_PER_THREAD)
+    {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer->events[index] = {name, phase, timestamp, duration, id};
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+Tracer::Span::Span(const char *name)
+    : name(name),
+      startedAt(enabled.load(std::memory_order_relaxed) ? now() : -1)
+{
+}
+
+Tracer::Span::~Span()
+{
+    if(startedAt >= 0 && enabled.load(std::memory_order_relaxed))
+        record(name, 'X', startedAt, now() - startedAt, 0);
+}
+
+void Tracer::start(int argc, char *argv[])
+{
+    traceClock.start();
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--trace") == 0)
+        {
+            exitFilePath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/trace.json";
+            setEnabled(true);
+        }
+        else if(std::strncmp(argv[i], "--trace=", 8) == 0)
+        {
+            exitFilePath = QString::fromLocal8Bit(argv[i] + 8);
+            setEnabled(true);
+        }
+    }
+}
+
+void Tracer::setEnabled(bool enable)
+{
+    enabled.store(enable);
+}
+
+bool Tracer::isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::instant(const char *name)
+{
+    if(isEnabled())
+        record(name, 'i', now(), 0, 0);
+}
+
+void Tracer::asyncBegin(const char *name, quint64 id)
+{
+    if(isEnabled())
+        record(name, 'b', now(), 0, id);
+}
+
+void Tracer::asyncEnd(const char *name, quint64 id)
+{
+    if(isEnabled())
+        record(name, 'e', now(), 0, id);
+}
+
+int Tracer::eventCount()
+{
+    QMutexLocker locker(&buffersMutex);
+
+    int total = 0;
+    for(const ThreadBuffer* buffer : qAsConst(buffers))
+        total += buffer->count.load(std::memory_order_acquire);
+    return total;
+}
+
+bool Tracer::exportJson(const QString &filePath)
+{
+    QFile file(filePath);
+
+    if(! file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qWarning() << "Tracer: cannot write" << filePath;
+        return false;
+    }
+
+    qint64 pid = QCoreApplication::applicationPid();
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    QMutexLocker locker(&buffersMutex);
+    bool first = true;
+    int dropped = 0;
+
+    for(const ThreadBuffer* buffer : qAsConst(buffers))
+    {
+        // other threads keep appending, everything below this count is stable
+        int count = buffer->count.load(std::memory_order_acquire);
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+        out << (first ? "" : ",\n")
+            << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+        first = false;
+
+        for(int i = 0; i < count; ++i)
+        {
+            const TraceEvent& event = buffer->events[i];
+            out << ",\n{\"ph\":\"" << event.phase << "\",\"name\":\"" << event.name << "\",\"cat\":\"qthisplayer\""
+                << ",\"pid\":" << pid << ",\"tid\":" << buffer->threadId << ",\"ts\":" << event.timestamp;
+
+            if(event.phase == 'X')
+                out << ",\"dur\":" << event.duration;
+            else if(event.phase == 'i')
+                out << ",\"s\":\"t\"";
+            else
+                out << ",\"id\":" << event.id;
+
+            out << '}';
+        }
+    }
+
+    out << "\n]}\n";
+
+    if(dropped > 0)
+        qWarning() << "Tracer:" << dropped << "events dropped, the per-thread buffers were full";
+
+    return true;
+}
+
+void Tracer::finish()
+{
+    if(exitFilePath.isEmpty())
+        return;
+
+    QDir().mkpath(QFileInfo(exitFilePath).absolutePath());
+    if(exportJson(exitFilePath))
+        qInfo() << "Tracer: trace written to" << exitFilePath;
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Records a span from here to the end of the scope. The name has to be a
+// string literal, only the pointer is stored.
+#define TRACE_SCOPE(name) Tracer::Span TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+// Playback lifecycle spans in Chrome's trace-event format, to load a session
+// into chrome://tracing or Perfetto. Every thread records into a buffer of its
+// own without taking a lock; while recording is off a span costs one atomic
+// load. Recording starts with --trace[=file.json], which also exports the
+// trace at exit, or from the View menu.
+class Tracer
+{
+public:
+    class Span
+    {
+    public:
+        explicit Span(const char* name);
+        ~Span();
+
+    private:
+        Q_DISABLE_COPY(Span)
+
+        const char* name;
+        qint64 startedAt;   // us, -1 when recording was off
+    };
+
+    static void start(int argc, char *argv[]);
+    static void setEnabled(bool enable);
+    static bool isEnabled();
+
+    static void instant(const char* name);
+    // spans that begin and end in different places or threads, matched by id
+    static void asyncBegin(const char* name, quint64 id);
+    static void asyncEnd(const char* name, quint64 id);
+
+    static int eventCount();
+    static bool exportJson(const QString& filePath);
+    static void finish();
+};
+
+#endif // TRACER_H
@@ -0,0 +1,120 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "vlcloader.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QDebug>
+
+#include "vlcqt/Instance.h"
+#include "vlcqt/MediaPlayer.h"
+#include "startuptrace.h"
+
+// rebuilding the cache is disk heavy, leave the first seconds to opening media
+const int REGENERATE_DELAY = 15000;
+
+VlcLoader* VlcLoader::self = nullptr;
+
+VlcLoader::VlcLoader(const QStringList &arguments, QObject *parent)
+    : QObject(parent),
+      mInstance(nullptr),
+      mPlayer(nullptr),
+      loaded(false)
+{
+    self = this;
+    QThread* guiThread = thread();
+
+    loaderThread = QThread::create([this, arguments, guiThread]
+    {
+        PluginCache::State cacheState = PluginCache::check(PluginCache::pluginPath());
+
+        QElapsedTimer timer;
+        timer.start();
+
+        // the player is a child of the instance and moves along with it
+        VlcInstance* vlcInstance = new VlcInstance(arguments);
+        VlcMediaPlayer* player = new VlcMediaPlayer(vlcInstance);
+        vlcInstance->moveToThread(guiThread);
+
+        qint64 elapsed = timer.elapsed();
+        QMetaObject::invokeMethod(this, [this, vlcInstance, player, elapsed, cacheState]
+        {
+            onLoaded(vlcInstance, player, elapsed, cacheState);
+        });
+    });
+    loaderThread->setObjectName("VlcLoader");
+    loaderThread->start();
+}
+
+VlcLoader::~VlcLoader()
+{
+    // quitting before libvlc was up, the queued hand over never ran
+    loaderThread->wait();
+    delete loaderThread;
+    QCoreApplication::sendPostedEvents(this);
+
+    if(mInstance)
+        delete mInstance;
+
+    self = nullptr;
+}
+
+VlcLoader *VlcLoader::instance()
+{
+    return self;
+}
+
+bool VlcLoader::isReady() const
+{
+    return loaded;
+}
+
+bool VlcLoader::take(VlcInstance **vlcInstance, VlcMediaPlayer **player)
+{
+    if(! mInstance)
+        return false;
+
+    *vlcInstance = mInstance;
+    *player = mPlayer;
+    mInstance = nullptr;
+    mPlayer = nullptr;
+    return true;
+}
+
+void VlcLoader::onLoaded(VlcInstance *vlcInstance, VlcMediaPlayer *player, qint64 elapsed, PluginCache::State cacheState)
+{
+    mInstance = vlcInstance;
+    mPlayer = player;
+    loaded = true;
+
+    qInfo() << "VlcLoader: libvlc and the player ready after" << elapsed << "ms";
+    StartupTrace::mark("vlc instance created");
+    PluginCache::recordLoadTime(cacheState, elapsed);
+
+    if(cacheState == PluginCache::MISSING || cacheState == PluginCache::STALE)
+    {
+        QTimer::singleShot(REGENERATE_DELAY, this, [this]
+        {
+            pluginCache.regenerate(PluginCache::pluginPath());
+        });
+    }
+
+    emit ready();
+}
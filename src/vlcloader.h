@@ -0,0 +1,62 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef VLCLOADER_H
+#define VLCLOADER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+
+#include "plugincache.h"
+
+class VlcInstance;
+class VlcMediaPlayer;
+
+// Creates the libvlc instance, which loads every plugin, and the media
+// player on a thread of its own, started from main() so plugin loading
+// overlaps building and showing the window. Both objects are handed to the
+// GUI thread, the first caller of take() owns them.
+class VlcLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VlcLoader(const QStringList& arguments, QObject *parent = nullptr);
+    ~VlcLoader();
+
+    static VlcLoader* instance();
+
+    bool isReady() const;
+    bool take(VlcInstance** vlcInstance, VlcMediaPlayer** player);
+
+signals:
+    void ready();
+
+private:
+    void onLoaded(VlcInstance* vlcInstance, VlcMediaPlayer* player, qint64 elapsed, PluginCache::State cacheState);
+
+    static VlcLoader* self;
+
+    QThread* loaderThread;
+    PluginCache pluginCache;
+    VlcInstance* mInstance;
+    VlcMediaPlayer* mPlayer;
+    bool loaded;
+};
+
+#endif // VLCLOADER_H
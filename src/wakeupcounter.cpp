@@ -0,0 +1,92 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "wakeupcounter.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <algorithm>
+
+WakeupCounter::WakeupCounter(QObject *parent)
+    : QObject(parent),
+      duration(0),
+      counting(false)
+{
+}
+
+WakeupCounter::~WakeupCounter()
+{
+    stop();
+}
+
+void WakeupCounter::start()
+{
+    counts.clear();
+    duration = 0;
+    counting = true;
+    clock.start();
+    QCoreApplication::instance()->installEventFilter(this);
+}
+
+void WakeupCounter::stop()
+{
+    if(! counting)
+        return;
+
+    counting = false;
+    duration = clock.elapsed();
+    QCoreApplication::instance()->removeEventFilter(this);
+}
+
+int WakeupCounter::total() const
+{
+    int sum = 0;
+    for(int count : counts)
+        sum += count;
+    return sum;
+}
+
+double WakeupCounter::perMinute() const
+{
+    qint64 elapsed = counting ? clock.elapsed() : duration;
+    return elapsed > 0 ? total() * 60000.0 / elapsed : 0;
+}
+
+QString WakeupCounter::report() const
+{
+    QList<QPair<int, QString>> sorted;
+    for(auto it = counts.constBegin(); it != counts.constEnd(); ++it)
+        sorted.append({it.value(), it.key()});
+    std::sort(sorted.begin(), sorted.end(), [] (const QPair<int, QString>& a, const QPair<int, QString>& b)
+    {
+        return a.first > b.first;
+    });
+
+    QString text = QString("%1 timer wakeups, %2 per minute").arg(total()).arg(perMinute(), 0, 'f', 1);
+    for(const auto& entry : sorted)
+        text += QString("\n%1: %2").arg(entry.second).arg(entry.first);
+    return text;
+}
+
+bool WakeupCounter::eventFilter(QObject *watched, QEvent *event)
+{
+    if(event->type() == QEvent::Timer)
+        ++counts[watched->metaObject()->className()];
+
+    return false;
+}
@@ -0,0 +1,51 @@
+/****************************************************************************
+* QThisPlayer - media player
+* Copyright (C) 2021 Helder Batalha <helderbatalha3@gmail.com>
+*
+* This library is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this library. If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef WAKEUPCOUNTER_H
+#define WAKEUPCOUNTER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+
+// Counts the timer events delivered in the GUI thread, grouped by the class
+// of the object receiving them, to check that nothing polls while idle.
+class WakeupCounter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit WakeupCounter(QObject *parent = nullptr);
+    ~WakeupCounter();
+
+    void start();
+    void stop();
+    int total() const;
+    double perMinute() const;
+    QString report() const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    QHash<QString, int> counts;
+    QElapsedTimer clock;
+    qint64 duration;
+    bool counting;
+};
+
+#endif // WAKEUPCOUNTER_H
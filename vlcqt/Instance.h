@@ -22,6 +22,7 @@
 #include <QObject>
 #include <QDebug>
 #include <QStringList>
+#include <QVector>
 
 #include <vlc/vlc.h>
 
@@ -48,23 +49,29 @@ public:
         \param args libvlc arguments (QStringList)
         \param parent Instance's parent object (QObject *)
     */
-    explicit VlcInstance(/*const QStringList &args,*/
+    explicit VlcInstance(const QStringList &args,
         QObject *parent = NULL)
-        : QObject(parent)
+        : QObject(parent),
+          _vlcInstance(nullptr),
+          _status(false)
     {
-//        // Convert arguments to required format
-//#if defined(Q_OS_WIN32) // Will be removed on Windows if confirmed working
-//        char **argv = (char **)malloc(sizeof(char **) * args.count());
-//        for (int i = 0; i < args.count(); ++i)
-//            argv[i] = (char *)qstrdup(args.at(i).toUtf8().data());
-//#else
-//        char *argv[args.count()];
-//        for (int i = 0; i < args.count(); ++i)
-//            argv[i] = (char *)qstrdup(args.at(i).toUtf8().data());
-//#endif
+        // Convert arguments to required format, the byte arrays keep the strings alive until libvlc_new returns
+        QList<QByteArray> utf8Args;
+        QVector<const char *> argv;
+        for (const QString &arg : args)
+            utf8Args.append(arg.toUtf8());
+        for (const QByteArray &arg : utf8Args)
+            argv.append(arg.constData());
 
         // Create new libvlc instance
-        _vlcInstance = libvlc_new(0, nullptr);
+        _vlcInstance = libvlc_new(argv.count(), argv.isEmpty() ? nullptr : argv.data());
+
+        // An unknown or malformed argument makes libvlc_new fail, fall back to the defaults
+        if (!_vlcInstance && !args.isEmpty())
+        {
+            qWarning() << "VLC-Qt Warning: libvlc rejected arguments" << args << "- using defaults";
+            _vlcInstance = libvlc_new(0, nullptr);
+        }
 
         qRegisterMetaType<Vlc::Meta>("Vlc::Meta");
         qRegisterMetaType<Vlc::State>("Vlc::State");
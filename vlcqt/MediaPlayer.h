@@ -725,6 +725,14 @@ public:
         return track;
     }
 
+    void setVideoTrack(int track)
+    {
+        if (_vlcMediaPlayer)
+        {
+            libvlc_video_set_track(_vlcMediaPlayer, track);
+        }
+    }
+
     int trackCount() const
     {
         int count = -1;
@@ -859,6 +867,28 @@ public:
 #endif
     }
 
+    /*!
+        \brief Set video callbacks.
+
+        Render video into memory provided by the callbacks instead of a
+        native window. Only takes effect for video outputs created after
+        the call, and cannot be undone for this player.
+
+        \param format format callback, chooses chroma, size and buffers
+        \param cleanup cleanup callback, releases what format allocated
+        \param lock lock callback, returns the buffer to render into
+        \param unlock unlock callback
+        \param display display callback, the picture is ready to show
+        \param opaque private pointer passed to lock, unlock and display
+    */
+    void setVideoCallbacks(libvlc_video_format_cb format, libvlc_video_cleanup_cb cleanup,
+                           libvlc_video_lock_cb lock, libvlc_video_unlock_cb unlock,
+                           libvlc_video_display_cb display, void *opaque)
+    {
+        libvlc_video_set_callbacks(_vlcMediaPlayer, lock, unlock, display, opaque);
+        libvlc_video_set_format_callbacks(_vlcMediaPlayer, format, cleanup);
+    }
+
     /*!
         \brief Get video output status
         \return video output status (const bool)
@@ -958,6 +988,33 @@ public:
         return sar;
     }
 
+    /*!
+        \brief Get frame rate of the current video track.
+        \return frames per second, 0 when unknown (float)
+    */
+    float frameRate()
+    {
+        if (!_vlcMediaPlayer || !_media)
+            return 0.0;
+        float fps = 0.0;
+
+        libvlc_media_track_t **tracks;
+        unsigned tracksCount;
+        tracksCount = libvlc_media_tracks_get(_media->core(), &tracks);
+        if (tracksCount > 0)
+        {
+            for (unsigned i = 0; i < tracksCount && fps == 0.0; i++)
+            {
+                libvlc_media_track_t *track = tracks[i];
+                if (track->i_type == libvlc_track_video && track->video->i_frame_rate_den > 0)
+                    fps = (float)track->video->i_frame_rate_num / (float)track->video->i_frame_rate_den;
+            }
+            libvlc_media_tracks_release(tracks, tracksCount);
+        }
+
+        return fps;
+    }
+
     /*!
         \brief Get current media playback rate( vlc >= 2.1.0 ).
         \return current media playback rate (float)